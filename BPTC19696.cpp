@@ -20,24 +20,121 @@
 #include "BPTC19696.h"
 
 #include "Hamming.h"
-#include "Utils.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
+// The row and column in the deinterleaved data of each transmitted bit, which is
+// at position ((i * 13) % 196) - 1 after the unused R(3) bit. The R(3) bit itself
+// is the first one transmitted and is skipped.
+const unsigned char DEINTERLEAVE_TABLE[] =
+	{0x00U, 0x0CU, 0x1AU, 0x28U, 0x36U, 0x44U, 0x52U, 0x60U, 0x6DU, 0x7BU, 0x89U, 0x97U, 0xA5U, 0xB3U,
+	 0xC1U, 0xCEU, 0x0BU, 0x19U, 0x27U, 0x35U, 0x43U, 0x51U, 0x5EU, 0x6CU, 0x7AU, 0x88U, 0x96U, 0xA4U,
+	 0xB2U, 0xC0U, 0xCDU, 0x0AU, 0x18U, 0x26U, 0x34U, 0x42U, 0x50U, 0x5DU, 0x6BU, 0x79U, 0x87U, 0x95U,
+	 0xA3U, 0xB1U, 0xBEU, 0xCCU, 0x09U, 0x17U, 0x25U, 0x33U, 0x41U, 0x4EU, 0x5CU, 0x6AU, 0x78U, 0x86U,
+	 0x94U, 0xA2U, 0xB0U, 0xBDU, 0xCBU, 0x08U, 0x16U, 0x24U, 0x32U, 0x40U, 0x4DU, 0x5BU, 0x69U, 0x77U,
+	 0x85U, 0x93U, 0xA1U, 0xAEU, 0xBCU, 0xCAU, 0x07U, 0x15U, 0x23U, 0x31U, 0x3EU, 0x4CU, 0x5AU, 0x68U,
+	 0x76U, 0x84U, 0x92U, 0xA0U, 0xADU, 0xBBU, 0xC9U, 0x06U, 0x14U, 0x22U, 0x30U, 0x3DU, 0x4BU, 0x59U,
+	 0x67U, 0x75U, 0x83U, 0x91U, 0x9EU, 0xACU, 0xBAU, 0xC8U, 0x05U, 0x13U, 0x21U, 0x2EU, 0x3CU, 0x4AU,
+	 0x58U, 0x66U, 0x74U, 0x82U, 0x90U, 0x9DU, 0xABU, 0xB9U, 0xC7U, 0x04U, 0x12U, 0x20U, 0x2DU, 0x3BU,
+	 0x49U, 0x57U, 0x65U, 0x73U, 0x81U, 0x8EU, 0x9CU, 0xAAU, 0xB8U, 0xC6U, 0x03U, 0x11U, 0x1EU, 0x2CU,
+	 0x3AU, 0x48U, 0x56U, 0x64U, 0x72U, 0x80U, 0x8DU, 0x9BU, 0xA9U, 0xB7U, 0xC5U, 0x02U, 0x10U, 0x1DU,
+	 0x2BU, 0x39U, 0x47U, 0x55U, 0x63U, 0x71U, 0x7EU, 0x8CU, 0x9AU, 0xA8U, 0xB6U, 0xC4U, 0x01U, 0x0EU,
+	 0x1CU, 0x2AU, 0x38U, 0x46U, 0x54U, 0x62U, 0x70U, 0x7DU, 0x8BU, 0x99U, 0xA7U, 0xB5U, 0xC3U, 0x00U,
+	 0x0DU, 0x1BU, 0x29U, 0x37U, 0x45U, 0x53U, 0x61U, 0x6EU, 0x7CU, 0x8AU, 0x98U, 0xA6U, 0xB4U, 0xC2U};
+
+// The burst and payload sizes, and the most bursts that can be worked on together
+const unsigned int BURST_LENGTH   = 33U;
+const unsigned int PAYLOAD_LENGTH = 12U;
+const unsigned int MAX_LANES      = 64U;
+
+// For the bit sliced versions, the bit to flip for each syndrome of the Hamming (13,9,3)
+// column code and the Hamming (15,11,3) row code, which is a row or a column of the
+// matrix respectively. The syndromes without one cannot be corrected.
+const unsigned int NO_CORRECTION = 0xFFU;
+
+const unsigned char COLUMN_CORRECT[] =
+	{NO_CORRECTION, 9U, 10U, 6U, 11U, 3U, 7U, 1U, 12U, NO_CORRECTION, 4U, NO_CORRECTION, 8U, 5U, 2U, 0U};
+
+const unsigned char ROW_CORRECT[] =
+	{NO_CORRECTION, 11U, 12U, 8U, 13U, 5U, 9U, 3U, 14U, 0U, 6U, 1U, 10U, 7U, 4U, 2U};
+
+// Transpose a 64 x 64 bit matrix held one row per word, with the first column in
+// the top bit of each word
+static void transpose(uint64_t* a)
+{
+	uint64_t m = 0x00000000FFFFFFFFULL;
+
+	for (unsigned int j = 32U; j != 0U; j >>= 1, m ^= m << j) {
+		for (unsigned int k = 0U; k < 64U; k = (k + j + 1U) & ~j) {
+			uint64_t t = (a[k] ^ (a[k + j] >> j)) & m;
+			a[k]     ^= t;
+			a[k + j] ^= t << j;
+		}
+	}
+}
+
+// Load up to eight bytes from each burst, starting at offset, and turn them into one
+// word per bit with one bit per burst
+static void loadSliced(const unsigned char* in, unsigned int stride, unsigned int count, unsigned int offset, unsigned int length, uint64_t* bits)
+{
+	for (unsigned int l = 0U; l < MAX_LANES; l++) {
+		uint64_t word = 0U;
+
+		if (l < count) {
+			const unsigned char* p = in + l * stride + offset;
+			for (unsigned int i = 0U; i < length; i++)
+				word |= uint64_t(p[i]) << (56U - i * 8U);
+		}
+
+		bits[l] = word;
+	}
+
+	transpose(bits);
+}
+
+// The reverse of the above, which overwrites the words in bits
+static void storeSliced(uint64_t* bits, unsigned int count, unsigned int offset, unsigned int length, unsigned char* out, unsigned int stride)
+{
+	transpose(bits);
+
+	for (unsigned int l = 0U; l < count; l++) {
+		unsigned char* p = out + l * stride + offset;
+		for (unsigned int i = 0U; i < length; i++)
+			p[i] = bits[l] >> (56U - i * 8U);
+	}
+}
+
+// Correct every burst of a bit sliced Hamming code word, where bit k of the code word is
+// at word[k * step], and return the bursts that were changed
+static uint64_t correctSliced(uint64_t* word, unsigned int step, const unsigned char* correct, uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3)
+{
+	if ((s0 | s1 | s2 | s3) == 0U)
+		return 0U;
+
+	uint64_t fixed = 0U;
+
+	for (unsigned int n = 1U; n < 16U; n++) {
+		if (correct[n] == NO_CORRECTION)
+			continue;
+
+		uint64_t lanes = ((n & 0x01U) ? s0 : ~s0) & ((n & 0x02U) ? s1 : ~s1) & ((n & 0x04U) ? s2 : ~s2) & ((n & 0x08U) ? s3 : ~s3);
+
+		word[correct[n] * step] ^= lanes;
+		fixed |= lanes;
+	}
+
+	return fixed;
+}
+
 CBPTC19696::CBPTC19696() :
-m_rawData(NULL),
-m_deInterData(NULL)
+m_rows()
 {
-	m_rawData     = new bool[196];
-	m_deInterData = new bool[196];
 }
 
 CBPTC19696::~CBPTC19696()
 {
-	delete[] m_rawData;
-	delete[] m_deInterData;
 }
 
 // The main decode function
@@ -46,11 +143,8 @@ void CBPTC19696::decode(const unsigned char* in, unsigned char* out)
 	assert(in != NULL);
 	assert(out != NULL);
 
-	//  Get the raw binary
-	decodeExtractBinary(in);
-
 	// Deinterleave
-	decodeDeInterleave();
+	decodeDeInterleave(in);
 
 	// Error check
 	decodeErrorCheck();
@@ -71,66 +165,30 @@ void CBPTC19696::encode(const unsigned char* in, unsigned char* out)
 	// Error check
 	encodeErrorCheck();
 
-	// Deinterleave
-	encodeInterleave();
-
-	//  Get the raw binary
-	encodeExtractBinary(out);
+	// Interleave
+	encodeInterleave(out);
 }
 
-void CBPTC19696::decodeExtractBinary(const unsigned char* in)
+// Deinterleave the raw data straight from the bytes of the burst
+void CBPTC19696::decodeDeInterleave(const unsigned char* in)
 {
-	// First block
-	CUtils::byteToBitsBE(in[0U],  m_rawData + 0U);
-	CUtils::byteToBitsBE(in[1U],  m_rawData + 8U);
-	CUtils::byteToBitsBE(in[2U],  m_rawData + 16U);
-	CUtils::byteToBitsBE(in[3U],  m_rawData + 24U);
-	CUtils::byteToBitsBE(in[4U],  m_rawData + 32U);
-	CUtils::byteToBitsBE(in[5U],  m_rawData + 40U);
-	CUtils::byteToBitsBE(in[6U],  m_rawData + 48U);
-	CUtils::byteToBitsBE(in[7U],  m_rawData + 56U);
-	CUtils::byteToBitsBE(in[8U],  m_rawData + 64U);
-	CUtils::byteToBitsBE(in[9U],  m_rawData + 72U);
-	CUtils::byteToBitsBE(in[10U], m_rawData + 80U);
-	CUtils::byteToBitsBE(in[11U], m_rawData + 88U);
-	CUtils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-	// Handle the two bits
-	bool bits[8U];
-	CUtils::byteToBitsBE(in[20U], bits);
-	m_rawData[98U] = bits[6U];
-	m_rawData[99U] = bits[7U];
-
-	// Second block
-	CUtils::byteToBitsBE(in[21U], m_rawData + 100U);
-	CUtils::byteToBitsBE(in[22U], m_rawData + 108U);
-	CUtils::byteToBitsBE(in[23U], m_rawData + 116U);
-	CUtils::byteToBitsBE(in[24U], m_rawData + 124U);
-	CUtils::byteToBitsBE(in[25U], m_rawData + 132U);
-	CUtils::byteToBitsBE(in[26U], m_rawData + 140U);
-	CUtils::byteToBitsBE(in[27U], m_rawData + 148U);
-	CUtils::byteToBitsBE(in[28U], m_rawData + 156U);
-	CUtils::byteToBitsBE(in[29U], m_rawData + 164U);
-	CUtils::byteToBitsBE(in[30U], m_rawData + 172U);
-	CUtils::byteToBitsBE(in[31U], m_rawData + 180U);
-	CUtils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
+	::memset(m_rows, 0x00U, sizeof(m_rows));
 
-// Deinterleave the raw data
-void CBPTC19696::decodeDeInterleave()
-{
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Shuffle the data
-		m_deInterData[a] = m_rawData[interleaveSequence];
+	for (unsigned int i = 1U; i < 98U; i++) {
+		unsigned int bit = (in[i >> 3] >> (7U - (i & 7U))) & 0x01U;
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		m_rows[pos >> 4] |= (bit << 14) >> (pos & 0x0FU);
+	}
+
+	// The second half follows the slot type and sync in the middle of the burst
+	for (unsigned int i = 98U; i < 196U; i++) {
+		unsigned int n = i + 68U;
+		unsigned int bit = (in[n >> 3] >> (7U - (n & 7U))) & 0x01U;
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		m_rows[pos >> 4] |= (bit << 14) >> (pos & 0x0FU);
 	}
 }
-	
+
 // Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
 void CBPTC19696::decodeErrorCheck()
 {
@@ -139,30 +197,36 @@ void CBPTC19696::decodeErrorCheck()
 	do {
 		fixing = false;
 
-		// Run through each of the 15 columns
-		bool col[13U];
-		for (unsigned int c = 0U; c < 15U; c++) {
-			unsigned int pos = c + 1U;
-			for (unsigned int a = 0U; a < 13U; a++) {
-				col[a] = m_deInterData[pos];
-				pos = pos + 15U;
-			}
+		// Find the columns with errors all at once, each syndrome word holds one bit
+		// per column, and only run those through the Hamming (13,9,3) code
+		unsigned int s0 = m_rows[0U] ^ m_rows[1U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[6U] ^ m_rows[9U];
+		unsigned int s1 = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[6U] ^ m_rows[7U] ^ m_rows[10U];
+		unsigned int s2 = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[7U] ^ m_rows[8U] ^ m_rows[11U];
+		unsigned int s3 = m_rows[0U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[5U] ^ m_rows[8U] ^ m_rows[12U];
+
+		unsigned int errors = s0 | s1 | s2 | s3;
+		for (unsigned int c = 0U; errors != 0U; c++) {
+			unsigned int bit = 0x4000U >> c;
+			if ((errors & bit) == 0U)
+				continue;
+
+			errors &= ~bit;
+
+			uint16_t col = 0U;
+			for (unsigned int r = 0U; r < 13U; r++)
+				col |= ((m_rows[r] & bit) >> (14U - c)) << (12U - r);
 
 			if (CHamming::decode1393(col)) {
-				unsigned int pos = c + 1U;
-				for (unsigned int a = 0U; a < 13U; a++) {
-					m_deInterData[pos] = col[a];
-					pos = pos + 15U;
-				}
+				for (unsigned int r = 0U; r < 13U; r++)
+					m_rows[r] = (m_rows[r] & ~bit) | (((col >> (12U - r)) & 0x01U) << (14U - c));
 
 				fixing = true;
 			}
 		}
-		
+
 		// Run through each of the 9 rows containing data
 		for (unsigned int r = 0U; r < 9U; r++) {
-			unsigned int pos = (r * 15U) + 1U;
-			if (CHamming::decode15113_2(m_deInterData + pos))
+			if (CHamming::decode15113_2(m_rows[r]))
 				fixing = true;
 		}
 
@@ -170,178 +234,227 @@ void CBPTC19696::decodeErrorCheck()
 	} while (fixing && count < 5U);
 }
 
-// Extract the 96 bits of payload
+// Extract the 96 bits of payload, eight from the first row and eleven from each of the rest
 void CBPTC19696::decodeExtractData(unsigned char* data) const
 {
-	bool bData[96U];
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	CUtils::bitsToByteBE(bData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(bData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(bData + 16U, data[2U]);
-	CUtils::bitsToByteBE(bData + 24U, data[3U]);
-	CUtils::bitsToByteBE(bData + 32U, data[4U]);
-	CUtils::bitsToByteBE(bData + 40U, data[5U]);
-	CUtils::bitsToByteBE(bData + 48U, data[6U]);
-	CUtils::bitsToByteBE(bData + 56U, data[7U]);
-	CUtils::bitsToByteBE(bData + 64U, data[8U]);
-	CUtils::bitsToByteBE(bData + 72U, data[9U]);
-	CUtils::bitsToByteBE(bData + 80U, data[10U]);
-	CUtils::bitsToByteBE(bData + 88U, data[11U]);
+	data[0U] = m_rows[0U] >> 4;
+
+	unsigned int pos  = 1U;
+	unsigned int acc  = 0U;
+	unsigned int bits = 0U;
+	for (unsigned int r = 1U; r < 9U; r++) {
+		acc   = (acc << 11) | ((m_rows[r] >> 4) & 0x7FFU);
+		bits += 11U;
+
+		while (bits >= 8U) {
+			bits -= 8U;
+			data[pos++] = acc >> bits;
+		}
+
+		acc &= (1U << bits) - 1U;
+	}
 }
 
-// Extract the 96 bits of payload
-void CBPTC19696::encodeExtractData(const unsigned char* in) const
+// Place the 96 bits of payload in the matrix
+void CBPTC19696::encodeExtractData(const unsigned char* in)
 {
-	bool bData[96U];
-	CUtils::byteToBitsBE(in[0U],  bData + 0U);
-	CUtils::byteToBitsBE(in[1U],  bData + 8U);
-	CUtils::byteToBitsBE(in[2U],  bData + 16U);
-	CUtils::byteToBitsBE(in[3U],  bData + 24U);
-	CUtils::byteToBitsBE(in[4U],  bData + 32U);
-	CUtils::byteToBitsBE(in[5U],  bData + 40U);
-	CUtils::byteToBitsBE(in[6U],  bData + 48U);
-	CUtils::byteToBitsBE(in[7U],  bData + 56U);
-	CUtils::byteToBitsBE(in[8U],  bData + 64U);
-	CUtils::byteToBitsBE(in[9U],  bData + 72U);
-	CUtils::byteToBitsBE(in[10U], bData + 80U);
-	CUtils::byteToBitsBE(in[11U], bData + 88U);
-
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		m_deInterData[a] = bData[pos];
+	::memset(m_rows, 0x00U, sizeof(m_rows));
+
+	m_rows[0U] = in[0U] << 4;
+
+	unsigned int pos  = 1U;
+	unsigned int acc  = 0U;
+	unsigned int bits = 0U;
+	for (unsigned int r = 1U; r < 9U; r++) {
+		while (bits < 11U) {
+			acc   = (acc << 8) | in[pos++];
+			bits += 8U;
+		}
+
+		bits -= 11U;
+		m_rows[r] = ((acc >> bits) & 0x7FFU) << 4;
+	}
 }
 
-// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
+// Encode each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
 void CBPTC19696::encodeErrorCheck()
 {
-	
 	// Run through each of the 9 rows containing data
-	for (unsigned int r = 0U; r < 9U; r++) {
-		unsigned int pos = (r * 15U) + 1U;
-		CHamming::encode15113_2(m_deInterData + pos);
+	for (unsigned int r = 0U; r < 9U; r++)
+		m_rows[r] = CHamming::encode15113_2(m_rows[r]);
+
+	// All 15 columns at once, the same as CHamming::encode1393() on each of them
+	m_rows[9U]  = m_rows[0U] ^ m_rows[1U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[6U];
+	m_rows[10U] = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[6U] ^ m_rows[7U];
+	m_rows[11U] = m_rows[0U] ^ m_rows[1U] ^ m_rows[2U] ^ m_rows[3U] ^ m_rows[5U] ^ m_rows[7U] ^ m_rows[8U];
+	m_rows[12U] = m_rows[0U] ^ m_rows[2U] ^ m_rows[4U] ^ m_rows[5U] ^ m_rows[8U];
+}
+
+// Interleave the matrix straight into the bytes of the burst, leaving the slot type and sync alone
+void CBPTC19696::encodeInterleave(unsigned char* data) const
+{
+	::memset(data + 0U, 0x00U, 12U);
+	data[12U] &= 0x3FU;
+	data[20U] &= 0xFCU;
+	::memset(data + 21U, 0x00U, 12U);
+
+	// The first bit is R(3) which is always zero
+	for (unsigned int i = 1U; i < 98U; i++) {
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		unsigned int bit = (m_rows[pos >> 4] >> (14U - (pos & 0x0FU))) & 0x01U;
+		data[i >> 3] |= bit << (7U - (i & 7U));
 	}
-	
-	// Run through each of the 15 columns
-	bool col[13U];
-	for (unsigned int c = 0U; c < 15U; c++) {
-		unsigned int pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			col[a] = m_deInterData[pos];
-			pos = pos + 15U;
-		}
 
-		CHamming::encode1393(col);
+	for (unsigned int i = 98U; i < 196U; i++) {
+		unsigned int n = i + 68U;
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		unsigned int bit = (m_rows[pos >> 4] >> (14U - (pos & 0x0FU))) & 0x01U;
+		data[n >> 3] |= bit << (7U - (n & 7U));
+	}
+}
 
-		pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			m_deInterData[pos] = col[a];
-			pos = pos + 15U;
-		}
+void CBPTC19696::decode(const unsigned char* in, unsigned char* out, unsigned int count)
+{
+	assert(in != NULL);
+	assert(out != NULL);
+
+	for (unsigned int n = 0U; n < count; n += MAX_LANES) {
+		unsigned int lanes = (count - n) < MAX_LANES ? (count - n) : MAX_LANES;
+
+		decodeSliced(in + n * BURST_LENGTH, out + n * PAYLOAD_LENGTH, lanes);
 	}
 }
 
-// Interleave the raw data
-void CBPTC19696::encodeInterleave()
+void CBPTC19696::encode(const unsigned char* in, unsigned char* out, unsigned int count)
 {
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_rawData[i] = false;
-
-	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Unshuffle the data
-		m_rawData[interleaveSequence] = m_deInterData[a];
+	assert(in != NULL);
+	assert(out != NULL);
+
+	for (unsigned int n = 0U; n < count; n += MAX_LANES) {
+		unsigned int lanes = (count - n) < MAX_LANES ? (count - n) : MAX_LANES;
+
+		encodeSliced(in + n * PAYLOAD_LENGTH, out + n * BURST_LENGTH, lanes);
 	}
 }
 
-void CBPTC19696::encodeExtractBinary(unsigned char* data)
+// The same steps as decode() above, on each bit of the matrix for up to 64 bursts at once
+void CBPTC19696::decodeSliced(const unsigned char* in, unsigned char* out, unsigned int count)
 {
-	// First block
-	CUtils::bitsToByteBE(m_rawData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_rawData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_rawData + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_rawData + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_rawData + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_rawData + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_rawData + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_rawData + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_rawData + 64U, data[8U]);
-	CUtils::bitsToByteBE(m_rawData + 72U, data[9U]);
-	CUtils::bitsToByteBE(m_rawData + 80U, data[10U]);
-	CUtils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-	// Handle the two bits
-	unsigned char byte;
-	CUtils::bitsToByteBE(m_rawData + 96U, byte);
-	data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-	data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-	// Second block
-	CUtils::bitsToByteBE(m_rawData + 100U,  data[21U]);
-	CUtils::bitsToByteBE(m_rawData + 108U,  data[22U]);
-	CUtils::bitsToByteBE(m_rawData + 116U,  data[23U]);
-	CUtils::bitsToByteBE(m_rawData + 124U,  data[24U]);
-	CUtils::bitsToByteBE(m_rawData + 132U,  data[25U]);
-	CUtils::bitsToByteBE(m_rawData + 140U,  data[26U]);
-	CUtils::bitsToByteBE(m_rawData + 148U,  data[27U]);
-	CUtils::bitsToByteBE(m_rawData + 156U,  data[28U]);
-	CUtils::bitsToByteBE(m_rawData + 164U,  data[29U]);
-	CUtils::bitsToByteBE(m_rawData + 172U,  data[30U]);
-	CUtils::bitsToByteBE(m_rawData + 180U,  data[31U]);
-	CUtils::bitsToByteBE(m_rawData + 188U,  data[32U]);
+	// Each bit of the bursts, rounded up to a whole number of words
+	uint64_t bits[5U * MAX_LANES];
+	for (unsigned int i = 0U; i < 5U; i++)
+		loadSliced(in, BURST_LENGTH, count, i * 8U, i < 4U ? 8U : 1U, bits + i * MAX_LANES);
+
+	// Deinterleave
+	uint64_t m[13U][15U];
+	for (unsigned int i = 1U; i < 196U; i++) {
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		m[pos >> 4][pos & 0x0FU] = bits[i < 98U ? i : i + 68U];
+	}
+
+	// Error check, until no burst changes or as many passes as decodeErrorCheck()
+	uint64_t fixing;
+	unsigned int passes = 0U;
+	do {
+		fixing = 0U;
+
+		for (unsigned int c = 0U; c < 15U; c++) {
+			uint64_t s0 = m[0U][c] ^ m[1U][c] ^ m[3U][c] ^ m[5U][c] ^ m[6U][c] ^ m[9U][c];
+			uint64_t s1 = m[0U][c] ^ m[1U][c] ^ m[2U][c] ^ m[4U][c] ^ m[6U][c] ^ m[7U][c] ^ m[10U][c];
+			uint64_t s2 = m[0U][c] ^ m[1U][c] ^ m[2U][c] ^ m[3U][c] ^ m[5U][c] ^ m[7U][c] ^ m[8U][c] ^ m[11U][c];
+			uint64_t s3 = m[0U][c] ^ m[2U][c] ^ m[4U][c] ^ m[5U][c] ^ m[8U][c] ^ m[12U][c];
+
+			fixing |= correctSliced(&m[0U][c], 15U, COLUMN_CORRECT, s0, s1, s2, s3);
+		}
+
+		for (unsigned int r = 0U; r < 9U; r++) {
+			const uint64_t* d = m[r];
+
+			uint64_t s0 = d[0U] ^ d[1U] ^ d[2U] ^ d[3U] ^ d[5U] ^ d[7U] ^ d[8U] ^ d[11U];
+			uint64_t s1 = d[1U] ^ d[2U] ^ d[3U] ^ d[4U] ^ d[6U] ^ d[8U] ^ d[9U] ^ d[12U];
+			uint64_t s2 = d[2U] ^ d[3U] ^ d[4U] ^ d[5U] ^ d[7U] ^ d[9U] ^ d[10U] ^ d[13U];
+			uint64_t s3 = d[0U] ^ d[1U] ^ d[2U] ^ d[4U] ^ d[6U] ^ d[7U] ^ d[10U] ^ d[14U];
+
+			fixing |= correctSliced(m[r], 1U, ROW_CORRECT, s0, s1, s2, s3);
+		}
+
+		// A burst with nothing to fix is left alone by any further passes
+		passes++;
+	} while (fixing != 0U && passes < 5U);
+
+	// Extract Data, eight bits from the first row and eleven from each of the rest
+	uint64_t data[2U * MAX_LANES];
+	::memset(data, 0x00U, sizeof(data));
+
+	for (unsigned int c = 3U; c < 11U; c++)
+		data[c - 3U] = m[0U][c];
+
+	for (unsigned int r = 1U; r < 9U; r++) {
+		for (unsigned int c = 0U; c < 11U; c++)
+			data[8U + (r - 1U) * 11U + c] = m[r][c];
+	}
+
+	storeSliced(data + 0U,        count, 0U, 8U, out, PAYLOAD_LENGTH);
+	storeSliced(data + MAX_LANES, count, 8U, 4U, out, PAYLOAD_LENGTH);
+}
+
+// The same steps as encode() above, on each bit of the matrix for up to 64 bursts at once
+void CBPTC19696::encodeSliced(const unsigned char* in, unsigned char* out, unsigned int count)
+{
+	uint64_t data[2U * MAX_LANES];
+	loadSliced(in, PAYLOAD_LENGTH, count, 0U, 8U, data + 0U);
+	loadSliced(in, PAYLOAD_LENGTH, count, 8U, 4U, data + MAX_LANES);
+
+	// Extract Data
+	uint64_t m[13U][15U];
+	::memset(m, 0x00U, sizeof(m));
+
+	for (unsigned int c = 3U; c < 11U; c++)
+		m[0U][c] = data[c - 3U];
+
+	for (unsigned int r = 1U; r < 9U; r++) {
+		for (unsigned int c = 0U; c < 11U; c++)
+			m[r][c] = data[8U + (r - 1U) * 11U + c];
+	}
+
+	// Error check, the rows and then the columns
+	for (unsigned int r = 0U; r < 9U; r++) {
+		uint64_t* d = m[r];
+
+		d[11U] = d[0U] ^ d[1U] ^ d[2U] ^ d[3U] ^ d[5U] ^ d[7U] ^ d[8U];
+		d[12U] = d[1U] ^ d[2U] ^ d[3U] ^ d[4U] ^ d[6U] ^ d[8U] ^ d[9U];
+		d[13U] = d[2U] ^ d[3U] ^ d[4U] ^ d[5U] ^ d[7U] ^ d[9U] ^ d[10U];
+		d[14U] = d[0U] ^ d[1U] ^ d[2U] ^ d[4U] ^ d[6U] ^ d[7U] ^ d[10U];
+	}
+
+	for (unsigned int c = 0U; c < 15U; c++) {
+		m[9U][c]  = m[0U][c] ^ m[1U][c] ^ m[3U][c] ^ m[5U][c] ^ m[6U][c];
+		m[10U][c] = m[0U][c] ^ m[1U][c] ^ m[2U][c] ^ m[4U][c] ^ m[6U][c] ^ m[7U][c];
+		m[11U][c] = m[0U][c] ^ m[1U][c] ^ m[2U][c] ^ m[3U][c] ^ m[5U][c] ^ m[7U][c] ^ m[8U][c];
+		m[12U][c] = m[0U][c] ^ m[2U][c] ^ m[4U][c] ^ m[5U][c] ^ m[8U][c];
+	}
+
+	// Interleave, with R(3) and the slot type and sync bits as zeros for now
+	uint64_t bits[5U * MAX_LANES];
+	::memset(bits, 0x00U, sizeof(bits));
+
+	for (unsigned int i = 1U; i < 196U; i++) {
+		unsigned char pos = DEINTERLEAVE_TABLE[i];
+		bits[i < 98U ? i : i + 68U] = m[pos >> 4][pos & 0x0FU];
+	}
+
+	unsigned char burst[5U * 8U * MAX_LANES];
+	for (unsigned int i = 0U; i < 5U; i++)
+		storeSliced(bits + i * MAX_LANES, count, i * 8U, 8U, burst, 5U * 8U);
+
+	// Copy in the payload, leaving the slot type and sync alone
+	for (unsigned int l = 0U; l < count; l++) {
+		const unsigned char* p = burst + l * 5U * 8U;
+		unsigned char* q = out + l * BURST_LENGTH;
+
+		::memcpy(q + 0U, p + 0U, 12U);
+		q[12U] = (q[12U] & 0x3FU) | p[12U];
+		q[20U] = (q[20U] & 0xFCU) | p[20U];
+		::memcpy(q + 21U, p + 21U, 12U);
+	}
 }
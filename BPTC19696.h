@@ -1,4 +1,5 @@
 /*
+ *	 Copyright (C) 2012 by Ian Wraith
  *   Copyright (C) 2015 by Jonathan Naylor G4KLX
  *
  *   This program is free software; you can redistribute it and/or modify
@@ -19,6 +20,8 @@
 #if !defined(BPTC19696_H)
 #define	BPTC19696_H
 
+#include <cstdint>
+
 class CBPTC19696
 {
 public:
@@ -29,19 +32,29 @@ public:
 
 	void encode(const unsigned char* in, unsigned char* out);
 
+	// The same as above for count bursts at once, each of 33 bytes with 12 bytes of
+	// payload, and with exactly the same results as one at a time. Up to 64 bursts
+	// are worked on together, with each bit of the matrix held as one word and a
+	// bit of that word for each burst.
+	static void decode(const unsigned char* in, unsigned char* out, unsigned int count);
+
+	static void encode(const unsigned char* in, unsigned char* out, unsigned int count);
+
 private:
-	bool* m_rawData;
-	bool* m_deInterData;
+	// The deinterleaved data as 13 rows of 15 bits, with column 0 in the top
+	// bit of each row. The unused R(3) bit in front of the matrix is not kept.
+	uint16_t m_rows[13U];
 
-	void decodeExtractBinary(const unsigned char* in);
+	void decodeDeInterleave(const unsigned char* in);
 	void decodeErrorCheck();
-	void decodeDeInterleave();
 	void decodeExtractData(unsigned char* data) const;
 
-	void encodeExtractData(const unsigned char* in) const;
-	void encodeInterleave();
+	void encodeExtractData(const unsigned char* in);
 	void encodeErrorCheck();
-	void encodeExtractBinary(unsigned char* data);
+	void encodeInterleave(unsigned char* data) const;
+
+	static void decodeSliced(const unsigned char* in, unsigned char* out, unsigned int count);
+	static void encodeSliced(const unsigned char* in, unsigned char* out, unsigned int count);
 };
 
 #endif
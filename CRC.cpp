@@ -18,7 +18,6 @@
 
 #include "CRC.h"
 
-#include "Utils.h"
 #include "Log.h"
 
 #include <cstdint>
@@ -118,8 +117,76 @@ const uint16_t CCITT16_TABLE2[] = {
 	0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
 	0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
 
+// The tables for slicing by eight, where entry [n][b] is the effect of the byte b
+// followed by n zero bytes. Row 0 is the byte table above, and the rest are
+// derived from it when the program starts.
+static uint8_t  CRC8_SLICES[8U][256U];
+static uint16_t CCITT16_SLICES1[8U][256U];
+static uint16_t CCITT16_SLICES2[8U][256U];
 
-bool CCRC::checkFiveBit(bool* in, unsigned int tcrc)
+static bool createSlices()
+{
+	for (unsigned int b = 0U; b < 256U; b++) {
+		CRC8_SLICES[0U][b]     = CRC8_TABLE[b];
+		CCITT16_SLICES1[0U][b] = CCITT16_TABLE1[b];
+		CCITT16_SLICES2[0U][b] = CCITT16_TABLE2[b];
+	}
+
+	for (unsigned int n = 1U; n < 8U; n++) {
+		for (unsigned int b = 0U; b < 256U; b++) {
+			uint8_t crc = CRC8_SLICES[n - 1U][b];
+			CRC8_SLICES[n][b] = CRC8_TABLE[crc];
+
+			uint16_t crc1 = CCITT16_SLICES1[n - 1U][b];
+			CCITT16_SLICES1[n][b] = (crc1 >> 8) ^ CCITT16_TABLE1[crc1 & 0xFFU];
+
+			uint16_t crc2 = CCITT16_SLICES2[n - 1U][b];
+			CCITT16_SLICES2[n][b] = uint16_t(crc2 << 8) ^ CCITT16_TABLE2[crc2 >> 8];
+		}
+	}
+
+	return true;
+}
+
+static const bool SLICES_CREATED = createSlices();
+
+// CCITT-16 with the bits reflected, as used by addCCITT161() and checkCCITT161()
+static uint16_t ccitt161(const unsigned char* in, unsigned int length)
+{
+	uint16_t crc = 0xFFFFU;
+
+	for (; length >= 8U; in += 8U, length -= 8U) {
+		crc = CCITT16_SLICES1[7U][in[0U] ^ (crc & 0xFFU)] ^ CCITT16_SLICES1[6U][in[1U] ^ (crc >> 8)] ^
+		      CCITT16_SLICES1[5U][in[2U]] ^ CCITT16_SLICES1[4U][in[3U]] ^
+		      CCITT16_SLICES1[3U][in[4U]] ^ CCITT16_SLICES1[2U][in[5U]] ^
+		      CCITT16_SLICES1[1U][in[6U]] ^ CCITT16_SLICES1[0U][in[7U]];
+	}
+
+	for (unsigned int i = 0U; i < length; i++)
+		crc = (crc >> 8) ^ CCITT16_TABLE1[(crc & 0xFFU) ^ in[i]];
+
+	return ~crc;
+}
+
+// CCITT-16 with the bits in order, as used by addCCITT162() and checkCCITT162()
+static uint16_t ccitt162(const unsigned char* in, unsigned int length)
+{
+	uint16_t crc = 0x0000U;
+
+	for (; length >= 8U; in += 8U, length -= 8U) {
+		crc = CCITT16_SLICES2[7U][in[0U] ^ (crc >> 8)] ^ CCITT16_SLICES2[6U][in[1U] ^ (crc & 0xFFU)] ^
+		      CCITT16_SLICES2[5U][in[2U]] ^ CCITT16_SLICES2[4U][in[3U]] ^
+		      CCITT16_SLICES2[3U][in[4U]] ^ CCITT16_SLICES2[2U][in[5U]] ^
+		      CCITT16_SLICES2[1U][in[6U]] ^ CCITT16_SLICES2[0U][in[7U]];
+	}
+
+	for (unsigned int i = 0U; i < length; i++)
+		crc = uint16_t(crc << 8) ^ CCITT16_TABLE2[(crc >> 8) ^ in[i]];
+
+	return ~crc;
+}
+
+bool CCRC::checkFiveBit(const unsigned char* in, unsigned int tcrc)
 {
 	assert(in != NULL);
 
@@ -129,16 +196,13 @@ bool CCRC::checkFiveBit(bool* in, unsigned int tcrc)
 	return crc == tcrc;
 }
 
-void CCRC::encodeFiveBit(const bool* in, unsigned int& tcrc)
+void CCRC::encodeFiveBit(const unsigned char* in, unsigned int& tcrc)
 {
 	assert(in != NULL);
 
 	unsigned short total = 0U;
-	for (unsigned int i = 0U; i < 72U; i += 8U) {
-		unsigned char c;
-		CUtils::bitsToByteBE(in + i, c);
-		total += c;
-	}
+	for (unsigned int i = 0U; i < 9U; i++)
+		total += in[i];
 
 	total %= 31U;
 
@@ -150,20 +214,10 @@ void CCRC::addCCITT162(unsigned char *in, unsigned int length)
 	assert(in != NULL);
 	assert(length > 2U);
 
-	union {
-		uint16_t crc16;
-		uint8_t  crc8[2U];
-	};
-
-	crc16 = 0U;
-
-	for (unsigned i = 0U; i < (length - 2U); i++)
-		crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
+	uint16_t crc = ccitt162(in, length - 2U);
 
-	crc16 = ~crc16;
-
-	in[length - 1U] = crc8[0U];
-	in[length - 2U] = crc8[1U];
+	in[length - 2U] = crc >> 8;
+	in[length - 1U] = crc & 0xFFU;
 }
 
 bool CCRC::checkCCITT162(const unsigned char *in, unsigned int length)
@@ -171,19 +225,9 @@ bool CCRC::checkCCITT162(const unsigned char *in, unsigned int length)
 	assert(in != NULL);
 	assert(length > 2U);
 
-	union {
-		uint16_t crc16;
-		uint8_t  crc8[2U];
-	};
-
-	crc16 = 0U;
+	uint16_t crc = ccitt162(in, length - 2U);
 
-	for (unsigned i = 0U; i < (length - 2U); i++)
-		crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
-
-	crc16 = ~crc16;
-
-	return crc8[0U] == in[length - 1U] && crc8[1U] == in[length - 2U];
+	return (crc >> 8) == in[length - 2U] && (crc & 0xFFU) == in[length - 1U];
 }
 
 void CCRC::addCCITT161(unsigned char *in, unsigned int length)
@@ -191,20 +235,10 @@ void CCRC::addCCITT161(unsigned char *in, unsigned int length)
 	assert(in != NULL);
 	assert(length > 2U);
 
-	union {
-		uint16_t crc16;
-		uint8_t  crc8[2U];
-	};
-
-	crc16 = 0xFFFFU;
-
-	for (unsigned int i = 0U; i < (length - 2U); i++)
-		crc16 = uint16_t(crc8[1U]) ^ CCITT16_TABLE1[crc8[0U] ^ in[i]];
-
-	crc16 = ~crc16;
+	uint16_t crc = ccitt161(in, length - 2U);
 
-	in[length - 2U] = crc8[0U];
-	in[length - 1U] = crc8[1U];
+	in[length - 2U] = crc & 0xFFU;
+	in[length - 1U] = crc >> 8;
 }
 
 bool CCRC::checkCCITT161(const unsigned char *in, unsigned int length)
@@ -212,19 +246,9 @@ bool CCRC::checkCCITT161(const unsigned char *in, unsigned int length)
 	assert(in != NULL);
 	assert(length > 2U);
 
-	union {
-		uint16_t crc16;
-		uint8_t  crc8[2U];
-	};
+	uint16_t crc = ccitt161(in, length - 2U);
 
-	crc16 = 0xFFFFU;
-
-	for (unsigned int i = 0U; i < (length - 2U); i++)
-		crc16 = uint16_t(crc8[1U]) ^ CCITT16_TABLE1[crc8[0U] ^ in[i]];
-
-	crc16 = ~crc16;
-
-	return crc8[0U] == in[length - 2U] && crc8[1U] == in[length - 1U];
+	return (crc & 0xFFU) == in[length - 2U] && (crc >> 8) == in[length - 1U];
 }
 
 unsigned char CCRC::crc8(const unsigned char *in, unsigned int length)
@@ -233,6 +257,13 @@ unsigned char CCRC::crc8(const unsigned char *in, unsigned int length)
 
 	uint8_t crc = 0U;
 
+	for (; length >= 8U; in += 8U, length -= 8U) {
+		crc = CRC8_SLICES[7U][in[0U] ^ crc] ^ CRC8_SLICES[6U][in[1U]] ^
+		      CRC8_SLICES[5U][in[2U]] ^ CRC8_SLICES[4U][in[3U]] ^
+		      CRC8_SLICES[3U][in[4U]] ^ CRC8_SLICES[2U][in[5U]] ^
+		      CRC8_SLICES[1U][in[6U]] ^ CRC8_SLICES[0U][in[7U]];
+	}
+
 	for (unsigned int i = 0U; i < length; i++)
 		crc = CRC8_TABLE[crc ^ in[i]];
 
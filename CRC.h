@@ -22,8 +22,8 @@
 class CCRC
 {
 public:
-	static bool checkFiveBit(bool* in, unsigned int tcrc);
-	static void encodeFiveBit(const bool* in, unsigned int& tcrc);
+	static bool checkFiveBit(const unsigned char* in, unsigned int tcrc);
+	static void encodeFiveBit(const unsigned char* in, unsigned int& tcrc);
 
 	static void addCCITT161(unsigned char* in, unsigned int length);
 	static void addCCITT162(unsigned char* in, unsigned int length);
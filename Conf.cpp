@@ -32,9 +32,7 @@ enum SECTION {
 	SECTION_LOG,
 	SECTION_VOICE,
 	SECTION_INFO,
-	SECTION_DMR_NETWORK_1,
-	SECTION_DMR_NETWORK_2,
-	SECTION_DMR_NETWORK_3,
+	SECTION_DMR_NETWORK,
 	SECTION_XLX_NETWORK
 };
 
@@ -48,6 +46,11 @@ m_localPort(62031U),
 m_rfTimeout(10U),
 m_netTimeout(10U),
 m_ruleTrace(false),
+m_packetBudget(10U),
+m_threaded(false),
+m_playoutDepth(0U),
+m_playoutDropOldest(true),
+m_dnsRefresh(300U),
 m_debug(false),
 m_voiceEnabled(true),
 m_voiceLanguage("en_GB"),
@@ -66,54 +69,7 @@ m_infoHeight(0),
 m_infoLocation(),
 m_infoDescription(),
 m_infoURL(),
-m_dmrNetwork1Enabled(false),
-m_dmrNetwork1Name(),
-m_dmrNetwork1Id(0U),
-m_dmrNetwork1Address(),
-m_dmrNetwork1Port(0U),
-m_dmrNetwork1Local(0U),
-m_dmrNetwork1Password(),
-m_dmrNetwork1Options(),
-m_dmrNetwork1Location(true),
-m_dmrNetwork1Debug(false),
-m_dmrNetwork1TGRewrites(),
-m_dmrNetwork1PCRewrites(),
-m_dmrNetwork1TypeRewrites(),
-m_dmrNetwork1SrcRewrites(),
-m_dmrNetwork1PassAllPC(),
-m_dmrNetwork1PassAllTG(),
-m_dmrNetwork2Enabled(false),
-m_dmrNetwork2Name(),
-m_dmrNetwork2Id(0U),
-m_dmrNetwork2Address(),
-m_dmrNetwork2Port(0U),
-m_dmrNetwork2Local(0U),
-m_dmrNetwork2Password(),
-m_dmrNetwork2Options(),
-m_dmrNetwork2Location(true),
-m_dmrNetwork2Debug(false),
-m_dmrNetwork2TGRewrites(),
-m_dmrNetwork2PCRewrites(),
-m_dmrNetwork2TypeRewrites(),
-m_dmrNetwork2SrcRewrites(),
-m_dmrNetwork2PassAllPC(),
-m_dmrNetwork2PassAllTG(),
-m_dmrNetwork3Enabled(false),
-m_dmrNetwork3Name(),
-m_dmrNetwork3Id(0U),
-m_dmrNetwork3Address(),
-m_dmrNetwork3Port(0U),
-m_dmrNetwork3Local(0U),
-m_dmrNetwork3Password(),
-m_dmrNetwork3Options(),
-m_dmrNetwork3Location(true),
-m_dmrNetwork3Debug(false),
-m_dmrNetwork3TGRewrites(),
-m_dmrNetwork3PCRewrites(),
-m_dmrNetwork3TypeRewrites(),
-m_dmrNetwork3SrcRewrites(),
-m_dmrNetwork3PassAllPC(),
-m_dmrNetwork3PassAllTG(),
+m_dmrNetworks(),
 m_xlxNetworkEnabled(false),
 m_xlxNetworkId(0U),
 m_xlxNetworkFile(),
@@ -145,6 +101,8 @@ bool CConf::read()
   }
 
   SECTION section = SECTION_NONE;
+  unsigned int number  = 0U;
+  unsigned int network = 0U;
 
   char buffer[BUFFER_SIZE];
   while (::fgets(buffer, BUFFER_SIZE, fp) != NULL) {
@@ -162,13 +120,10 @@ bool CConf::read()
 			section = SECTION_INFO;
 		else if (::strncmp(buffer, "[XLX Network]", 13U) == 0)
 			section = SECTION_XLX_NETWORK;
-		else if (::strncmp(buffer, "[DMR Network 1]", 15U) == 0)
-			section = SECTION_DMR_NETWORK_1;
-		else if (::strncmp(buffer, "[DMR Network 2]", 15U) == 0)
-			section = SECTION_DMR_NETWORK_2;
-		else if (::strncmp(buffer, "[DMR Network 3]", 15U) == 0)
-			section = SECTION_DMR_NETWORK_3;
-		else
+		else if (::sscanf(buffer, "[DMR Network %u]", &number) == 1 && number > 0U) {
+			network = findDMRNetwork(number);
+			section = SECTION_DMR_NETWORK;
+		} else
 			section = SECTION_NONE;
 
 		continue;
@@ -208,6 +163,16 @@ bool CConf::read()
 				m_localPort = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "RuleTrace") == 0)
 				m_ruleTrace = ::atoi(value) == 1;
+			else if (::strcmp(key, "PacketBudget") == 0)
+				m_packetBudget = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "Threaded") == 0)
+				m_threaded = ::atoi(value) == 1;
+			else if (::strcmp(key, "PlayoutDepth") == 0)
+				m_playoutDepth = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "PlayoutDropOldest") == 0)
+				m_playoutDropOldest = ::atoi(value) == 1;
+			else if (::strcmp(key, "DNSRefresh") == 0)
+				m_dnsRefresh = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "Debug") == 0)
 				m_debug = ::atoi(value) == 1;
 		} else if (section == SECTION_LOG) {
@@ -278,199 +243,31 @@ bool CConf::read()
                 m_xlxNetworkUserControl = ::atoi(value) ==1;
             else if (::strcmp(key, "Module") == 0)
                 m_xlxNetworkModule = ::toupper(value[0]);
-		} else if (section == SECTION_DMR_NETWORK_1) {
-			if (::strcmp(key, "Enabled") == 0)
-				m_dmrNetwork1Enabled = ::atoi(value) == 1;
-			else if (::strcmp(key, "Name") == 0)
-				m_dmrNetwork1Name = value;
-			else if (::strcmp(key, "Id") == 0)
-				m_dmrNetwork1Id = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Address") == 0)
-				m_dmrNetwork1Address = value;
-			else if (::strcmp(key, "Port") == 0)
-				m_dmrNetwork1Port = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Local") == 0)
-				m_dmrNetwork1Local = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Password") == 0)
-				m_dmrNetwork1Password = value;
-			else if (::strcmp(key, "Options") == 0)
-				m_dmrNetwork1Options = value;
-			else if (::strcmp(key, "Location") == 0)
-				m_dmrNetwork1Location = ::atoi(value) == 1;
-			else if (::strcmp(key, "Debug") == 0)
-				m_dmrNetwork1Debug = ::atoi(value) == 1;
-			else if (::strncmp(key, "TGRewrite", 9U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CTGRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromTG   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toTG     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork1TGRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "PCRewrite", 9U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CPCRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromId   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toId     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork1PCRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "TypeRewrite", 11U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL) {
-					CTypeRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromTG   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toId     = ::atoi(p4);
-					m_dmrNetwork1TypeRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "SrcRewrite", 10U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CSrcRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromId   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toTG     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork1SrcRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "PassAllPC", 9U) == 0) {
-				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork1PassAllPC.push_back(slotNo);
-			} else if (::strncmp(key, "PassAllTG", 9U) == 0) {
-				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork1PassAllTG.push_back(slotNo);
-			}
-		} else if (section == SECTION_DMR_NETWORK_2) {
-			if (::strcmp(key, "Enabled") == 0)
-				m_dmrNetwork2Enabled = ::atoi(value) == 1;
-			else if (::strcmp(key, "Name") == 0)
-				m_dmrNetwork2Name = value;
-			else if (::strcmp(key, "Id") == 0)
-				m_dmrNetwork2Id = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Address") == 0)
-				m_dmrNetwork2Address = value;
-			else if (::strcmp(key, "Port") == 0)
-				m_dmrNetwork2Port = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Local") == 0)
-				m_dmrNetwork2Local = (unsigned int)::atoi(value);
-			else if (::strcmp(key, "Password") == 0)
-				m_dmrNetwork2Password = value;
-			else if (::strcmp(key, "Options") == 0)
-				m_dmrNetwork2Options = value;
-			else if (::strcmp(key, "Location") == 0)
-				m_dmrNetwork2Location = ::atoi(value) == 1;
-			else if (::strcmp(key, "Debug") == 0)
-				m_dmrNetwork2Debug = ::atoi(value) == 1;
-			else if (::strncmp(key, "TGRewrite", 9U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CTGRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromTG   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toTG     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork2TGRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "PCRewrite", 9U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CPCRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromId   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toId     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork2PCRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "TypeRewrite", 11U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL) {
-					CTypeRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromTG   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toId     = ::atoi(p4);
-					m_dmrNetwork2TypeRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "SrcRewrite", 10U) == 0) {
-				char* p1 = ::strtok(value, ", ");
-				char* p2 = ::strtok(NULL, ", ");
-				char* p3 = ::strtok(NULL, ", ");
-				char* p4 = ::strtok(NULL, ", ");
-				char* p5 = ::strtok(NULL, " \r\n");
-				if (p1 != NULL && p2 != NULL && p3 != NULL && p4 != NULL && p5 != NULL) {
-					CSrcRewriteStruct rewrite;
-					rewrite.m_fromSlot = ::atoi(p1);
-					rewrite.m_fromId   = ::atoi(p2);
-					rewrite.m_toSlot   = ::atoi(p3);
-					rewrite.m_toTG     = ::atoi(p4);
-					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork2SrcRewrites.push_back(rewrite);
-				}
-			} else if (::strncmp(key, "PassAllPC", 9U) == 0) {
-				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork2PassAllPC.push_back(slotNo);
-			} else if (::strncmp(key, "PassAllTG", 9U) == 0) {
-				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork2PassAllTG.push_back(slotNo);
-			}
-		} else if (section == SECTION_DMR_NETWORK_3) {
+		} else if (section == SECTION_DMR_NETWORK) {
+			CDMRNetworkStruct& dmrNetwork = m_dmrNetworks[network];
+
 			if (::strcmp(key, "Enabled") == 0)
-				m_dmrNetwork3Enabled = ::atoi(value) == 1;
+				dmrNetwork.m_enabled = ::atoi(value) == 1;
 			else if (::strcmp(key, "Name") == 0)
-				m_dmrNetwork3Name = value;
+				dmrNetwork.m_name = value;
 			else if (::strcmp(key, "Id") == 0)
-				m_dmrNetwork3Id = (unsigned int)::atoi(value);
+				dmrNetwork.m_id = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "Address") == 0)
-				m_dmrNetwork3Address = value;
+				dmrNetwork.m_address = value;
 			else if (::strcmp(key, "Port") == 0)
-				m_dmrNetwork3Port = (unsigned int)::atoi(value);
+				dmrNetwork.m_port = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "Local") == 0)
-				m_dmrNetwork3Local = (unsigned int)::atoi(value);
+				dmrNetwork.m_local = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "Password") == 0)
-				m_dmrNetwork3Password = value;
+				dmrNetwork.m_password = value;
 			else if (::strcmp(key, "Options") == 0)
-				m_dmrNetwork3Options = value;
+				dmrNetwork.m_options = value;
 			else if (::strcmp(key, "Location") == 0)
-				m_dmrNetwork3Location = ::atoi(value) == 1;
+				dmrNetwork.m_location = ::atoi(value) == 1;
 			else if (::strcmp(key, "Debug") == 0)
-				m_dmrNetwork3Debug = ::atoi(value) == 1;
+				dmrNetwork.m_debug = ::atoi(value) == 1;
+			else if (::strcmp(key, "Jitter") == 0)
+				dmrNetwork.m_jitter = (unsigned int)::atoi(value);
 			else if (::strncmp(key, "TGRewrite", 9U) == 0) {
 				char* p1 = ::strtok(value, ", ");
 				char* p2 = ::strtok(NULL, ", ");
@@ -484,7 +281,7 @@ bool CConf::read()
 					rewrite.m_toSlot   = ::atoi(p3);
 					rewrite.m_toTG     = ::atoi(p4);
 					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork3TGRewrites.push_back(rewrite);
+					dmrNetwork.m_tgRewrites.push_back(rewrite);
 				}
 			} else if (::strncmp(key, "PCRewrite", 9U) == 0) {
 				char* p1 = ::strtok(value, ", ");
@@ -499,7 +296,7 @@ bool CConf::read()
 					rewrite.m_toSlot   = ::atoi(p3);
 					rewrite.m_toId     = ::atoi(p4);
 					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork3PCRewrites.push_back(rewrite);
+					dmrNetwork.m_pcRewrites.push_back(rewrite);
 				}
 			} else if (::strncmp(key, "TypeRewrite", 11U) == 0) {
 				char* p1 = ::strtok(value, ", ");
@@ -512,7 +309,7 @@ bool CConf::read()
 					rewrite.m_fromTG   = ::atoi(p2);
 					rewrite.m_toSlot   = ::atoi(p3);
 					rewrite.m_toId     = ::atoi(p4);
-					m_dmrNetwork3TypeRewrites.push_back(rewrite);
+					dmrNetwork.m_typeRewrites.push_back(rewrite);
 				}
 			} else if (::strncmp(key, "SrcRewrite", 10U) == 0) {
 				char* p1 = ::strtok(value, ", ");
@@ -527,14 +324,14 @@ bool CConf::read()
 					rewrite.m_toSlot   = ::atoi(p3);
 					rewrite.m_toTG     = ::atoi(p4);
 					rewrite.m_range    = ::atoi(p5);
-					m_dmrNetwork3SrcRewrites.push_back(rewrite);
+					dmrNetwork.m_srcRewrites.push_back(rewrite);
 				}
 			} else if (::strncmp(key, "PassAllPC", 9U) == 0) {
 				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork3PassAllPC.push_back(slotNo);
+				dmrNetwork.m_passAllPC.push_back(slotNo);
 			} else if (::strncmp(key, "PassAllTG", 9U) == 0) {
 				unsigned int slotNo = (unsigned int)::atoi(value);
-				m_dmrNetwork3PassAllTG.push_back(slotNo);
+				dmrNetwork.m_passAllTG.push_back(slotNo);
 			}
 		}
 	}
@@ -584,6 +381,31 @@ bool CConf::getRuleTrace() const
 	return m_ruleTrace;
 }
 
+unsigned int CConf::getPacketBudget() const
+{
+	return m_packetBudget;
+}
+
+bool CConf::getThreaded() const
+{
+	return m_threaded;
+}
+
+unsigned int CConf::getPlayoutDepth() const
+{
+	return m_playoutDepth;
+}
+
+bool CConf::getPlayoutDropOldest() const
+{
+	return m_playoutDropOldest;
+}
+
+unsigned int CConf::getDNSRefresh() const
+{
+	return m_dnsRefresh;
+}
+
 bool CConf::getDebug() const
 {
 	return m_debug;
@@ -747,251 +569,35 @@ char CConf::getXLXNetworkModule() const
 	return m_xlxNetworkModule;
 }
 
-bool CConf::getDMRNetwork1Enabled() const
-{
-	return m_dmrNetwork1Enabled;
-}
-
-std::string CConf::getDMRNetwork1Name() const
-{
-	if (m_dmrNetwork1Name.empty())
-		return "DMR-1";
-	else
-		return m_dmrNetwork1Name;
-}
-
-unsigned int CConf::getDMRNetwork1Id() const
-{
-	return m_dmrNetwork1Id;
-}
-
-std::string CConf::getDMRNetwork1Address() const
-{
-	return m_dmrNetwork1Address;
-}
-
-unsigned int CConf::getDMRNetwork1Port() const
-{
-	return m_dmrNetwork1Port;
-}
-
-unsigned int CConf::getDMRNetwork1Local() const
-{
-	return m_dmrNetwork1Local;
-}
-
-std::string CConf::getDMRNetwork1Password() const
-{
-	return m_dmrNetwork1Password;
-}
-
-std::string CConf::getDMRNetwork1Options() const
-{
-	return m_dmrNetwork1Options;
-}
-
-bool CConf::getDMRNetwork1Location() const
-{
-	return m_dmrNetwork1Location;
-}
-
-bool CConf::getDMRNetwork1Debug() const
-{
-	return m_dmrNetwork1Debug;
-}
-
-std::vector<CTGRewriteStruct> CConf::getDMRNetwork1TGRewrites() const
-{
-	return m_dmrNetwork1TGRewrites;
-}
-
-std::vector<CPCRewriteStruct> CConf::getDMRNetwork1PCRewrites() const
-{
-	return m_dmrNetwork1PCRewrites;
-}
-
-std::vector<CTypeRewriteStruct> CConf::getDMRNetwork1TypeRewrites() const
-{
-	return m_dmrNetwork1TypeRewrites;
-}
-
-std::vector<CSrcRewriteStruct> CConf::getDMRNetwork1SrcRewrites() const
-{
-	return m_dmrNetwork1SrcRewrites;
-}
-
-std::vector<unsigned int> CConf::getDMRNetwork1PassAllPC() const
-{
-	return m_dmrNetwork1PassAllPC;
-}
-
-std::vector<unsigned int> CConf::getDMRNetwork1PassAllTG() const
-{
-	return m_dmrNetwork1PassAllTG;
-}
-
-bool CConf::getDMRNetwork2Enabled() const
-{
-	return m_dmrNetwork2Enabled;
-}
-
-std::string CConf::getDMRNetwork2Name() const
-{
-	if (m_dmrNetwork2Name.empty())
-		return "DMR-2";
-	else
-		return m_dmrNetwork2Name;
-}
-
-unsigned int CConf::getDMRNetwork2Id() const
-{
-	return m_dmrNetwork2Id;
-}
-
-std::string CConf::getDMRNetwork2Address() const
-{
-	return m_dmrNetwork2Address;
-}
-
-unsigned int CConf::getDMRNetwork2Port() const
-{
-	return m_dmrNetwork2Port;
-}
-
-unsigned int CConf::getDMRNetwork2Local() const
+std::vector<CDMRNetworkStruct> CConf::getDMRNetworks() const
 {
-	return m_dmrNetwork2Local;
+	return m_dmrNetworks;
 }
 
-std::string CConf::getDMRNetwork2Password() const
+// Repeated sections with the same number are merged, as they always have been
+unsigned int CConf::findDMRNetwork(unsigned int number)
 {
-	return m_dmrNetwork2Password;
-}
-
-std::string CConf::getDMRNetwork2Options() const
-{
-	return m_dmrNetwork2Options;
-}
-
-bool CConf::getDMRNetwork2Location() const
-{
-	return m_dmrNetwork2Location;
-}
-
-bool CConf::getDMRNetwork2Debug() const
-{
-	return m_dmrNetwork2Debug;
-}
-
-std::vector<CTGRewriteStruct> CConf::getDMRNetwork2TGRewrites() const
-{
-	return m_dmrNetwork2TGRewrites;
-}
-
-std::vector<CPCRewriteStruct> CConf::getDMRNetwork2PCRewrites() const
-{
-	return m_dmrNetwork2PCRewrites;
-}
-
-std::vector<CTypeRewriteStruct> CConf::getDMRNetwork2TypeRewrites() const
-{
-	return m_dmrNetwork2TypeRewrites;
-}
-
-std::vector<CSrcRewriteStruct> CConf::getDMRNetwork2SrcRewrites() const
-{
-	return m_dmrNetwork2SrcRewrites;
-}
-
-std::vector<unsigned int> CConf::getDMRNetwork2PassAllPC() const
-{
-	return m_dmrNetwork2PassAllPC;
-}
-
-std::vector<unsigned int> CConf::getDMRNetwork2PassAllTG() const
-{
-	return m_dmrNetwork2PassAllTG;
-}
-
-bool CConf::getDMRNetwork3Enabled() const
-{
-	return m_dmrNetwork3Enabled;
-}
-
-std::string CConf::getDMRNetwork3Name() const
-{
-	if (m_dmrNetwork3Name.empty())
-		return "DMR-3";
-	else
-		return m_dmrNetwork3Name;
-}
-
-unsigned int CConf::getDMRNetwork3Id() const
-{
-	return m_dmrNetwork3Id;
-}
-
-std::string CConf::getDMRNetwork3Address() const
-{
-	return m_dmrNetwork3Address;
-}
-
-unsigned int CConf::getDMRNetwork3Port() const
-{
-	return m_dmrNetwork3Port;
-}
-
-unsigned int CConf::getDMRNetwork3Local() const
-{
-	return m_dmrNetwork3Local;
-}
-
-std::string CConf::getDMRNetwork3Password() const
-{
-	return m_dmrNetwork3Password;
-}
-
-std::string CConf::getDMRNetwork3Options() const
-{
-	return m_dmrNetwork3Options;
-}
-
-bool CConf::getDMRNetwork3Location() const
-{
-	return m_dmrNetwork3Location;
-}
-
-bool CConf::getDMRNetwork3Debug() const
-{
-	return m_dmrNetwork3Debug;
-}
-
-std::vector<CTGRewriteStruct> CConf::getDMRNetwork3TGRewrites() const
-{
-	return m_dmrNetwork3TGRewrites;
-}
-
-std::vector<CPCRewriteStruct> CConf::getDMRNetwork3PCRewrites() const
-{
-	return m_dmrNetwork3PCRewrites;
-}
+	for (unsigned int i = 0U; i < m_dmrNetworks.size(); i++) {
+		if (m_dmrNetworks[i].m_number == number)
+			return i;
+	}
 
-std::vector<CTypeRewriteStruct> CConf::getDMRNetwork3TypeRewrites() const
-{
-	return m_dmrNetwork3TypeRewrites;
-}
+	CDMRNetworkStruct dmrNetwork;
+	dmrNetwork.m_number   = number;
+	dmrNetwork.m_enabled  = false;
+	dmrNetwork.m_id       = 0U;
+	dmrNetwork.m_port     = 0U;
+	dmrNetwork.m_local    = 0U;
+	dmrNetwork.m_location = true;
+	dmrNetwork.m_debug    = false;
+	dmrNetwork.m_jitter   = 0U;
 
-std::vector<CSrcRewriteStruct> CConf::getDMRNetwork3SrcRewrites() const
-{
-	return m_dmrNetwork3SrcRewrites;
-}
+	// Keep the networks in the order of their section numbers
+	std::vector<CDMRNetworkStruct>::iterator it = m_dmrNetworks.begin();
+	while (it != m_dmrNetworks.end() && (*it).m_number < number)
+		++it;
 
-std::vector<unsigned int> CConf::getDMRNetwork3PassAllPC() const
-{
-	return m_dmrNetwork3PassAllPC;
-}
+	it = m_dmrNetworks.insert(it, dmrNetwork);
 
-std::vector<unsigned int> CConf::getDMRNetwork3PassAllTG() const
-{
-	return m_dmrNetwork3PassAllTG;
+	return (unsigned int)(it - m_dmrNetworks.begin());
 }
@@ -53,6 +53,27 @@ struct CSrcRewriteStruct {
 	unsigned int m_range;
 };
 
+struct CDMRNetworkStruct {
+	unsigned int                    m_number;
+	bool                            m_enabled;
+	std::string                     m_name;
+	unsigned int                    m_id;
+	std::string                     m_address;
+	unsigned int                    m_port;
+	unsigned int                    m_local;
+	std::string                     m_password;
+	std::string                     m_options;
+	bool                            m_location;
+	bool                            m_debug;
+	unsigned int                    m_jitter;
+	std::vector<CTGRewriteStruct>   m_tgRewrites;
+	std::vector<CPCRewriteStruct>   m_pcRewrites;
+	std::vector<CTypeRewriteStruct> m_typeRewrites;
+	std::vector<CSrcRewriteStruct>  m_srcRewrites;
+	std::vector<unsigned int>       m_passAllPC;
+	std::vector<unsigned int>       m_passAllTG;
+};
+
 class CConf
 {
 public:
@@ -70,6 +91,11 @@ public:
 	std::string  getLocalAddress() const;
 	unsigned int getLocalPort() const;
 	bool         getRuleTrace() const;
+	unsigned int getPacketBudget() const;
+	bool         getThreaded() const;
+	unsigned int getPlayoutDepth() const;
+	bool         getPlayoutDropOldest() const;
+	unsigned int getDNSRefresh() const;
 	bool         getDebug() const;
 
 	// The Log section
@@ -95,59 +121,8 @@ public:
 	std::string  getInfoDescription() const;
 	std::string  getInfoURL() const;
 
-	// The DMR Network 1 section
-	bool         getDMRNetwork1Enabled() const;
-	std::string  getDMRNetwork1Name() const;
-	unsigned int getDMRNetwork1Id() const;
-	std::string  getDMRNetwork1Address() const;
-	unsigned int getDMRNetwork1Port() const;
-	unsigned int getDMRNetwork1Local() const;
-	std::string  getDMRNetwork1Password() const;
-	std::string  getDMRNetwork1Options() const;
-	bool         getDMRNetwork1Location() const;
-	bool         getDMRNetwork1Debug() const;
-	std::vector<CTGRewriteStruct>   getDMRNetwork1TGRewrites() const;
-	std::vector<CPCRewriteStruct>   getDMRNetwork1PCRewrites() const;
-	std::vector<CTypeRewriteStruct> getDMRNetwork1TypeRewrites() const;
-	std::vector<CSrcRewriteStruct>  getDMRNetwork1SrcRewrites() const;
-	std::vector<unsigned int>       getDMRNetwork1PassAllPC() const;
-	std::vector<unsigned int>       getDMRNetwork1PassAllTG() const;
-
-	// The DMR Network 2 section
-	bool         getDMRNetwork2Enabled() const;
-	std::string  getDMRNetwork2Name() const;
-	unsigned int getDMRNetwork2Id() const;
-	std::string  getDMRNetwork2Address() const;
-	unsigned int getDMRNetwork2Port() const;
-	unsigned int getDMRNetwork2Local() const;
-	std::string  getDMRNetwork2Password() const;
-	std::string  getDMRNetwork2Options() const;
-	bool         getDMRNetwork2Location() const;
-	bool         getDMRNetwork2Debug() const;
-	std::vector<CTGRewriteStruct>   getDMRNetwork2TGRewrites() const;
-	std::vector<CPCRewriteStruct>   getDMRNetwork2PCRewrites() const;
-	std::vector<CTypeRewriteStruct> getDMRNetwork2TypeRewrites() const;
-	std::vector<CSrcRewriteStruct>  getDMRNetwork2SrcRewrites() const;
-	std::vector<unsigned int>       getDMRNetwork2PassAllPC() const;
-	std::vector<unsigned int>       getDMRNetwork2PassAllTG() const;
-
-	// The DMR Network 3 section
-	bool         getDMRNetwork3Enabled() const;
-	std::string  getDMRNetwork3Name() const;
-	unsigned int getDMRNetwork3Id() const;
-	std::string  getDMRNetwork3Address() const;
-	unsigned int getDMRNetwork3Port() const;
-	unsigned int getDMRNetwork3Local() const;
-	std::string  getDMRNetwork3Password() const;
-	std::string  getDMRNetwork3Options() const;
-	bool         getDMRNetwork3Location() const;
-	bool         getDMRNetwork3Debug() const;
-	std::vector<CTGRewriteStruct>   getDMRNetwork3TGRewrites() const;
-	std::vector<CPCRewriteStruct>   getDMRNetwork3PCRewrites() const;
-	std::vector<CTypeRewriteStruct> getDMRNetwork3TypeRewrites() const;
-	std::vector<CSrcRewriteStruct>  getDMRNetwork3SrcRewrites() const;
-	std::vector<unsigned int>       getDMRNetwork3PassAllPC() const;
-	std::vector<unsigned int>       getDMRNetwork3PassAllTG() const;
+	// The DMR Network N sections, in order of their numbers
+	std::vector<CDMRNetworkStruct> getDMRNetworks() const;
 
 	// The XLX Network section
 	bool         getXLXNetworkEnabled() const;
@@ -176,6 +151,11 @@ private:
 	unsigned int m_rfTimeout;
 	unsigned int m_netTimeout;
 	bool         m_ruleTrace;
+	unsigned int m_packetBudget;
+	bool         m_threaded;
+	unsigned int m_playoutDepth;
+	bool         m_playoutDropOldest;
+	unsigned int m_dnsRefresh;
 	bool         m_debug;
 
 	bool         m_voiceEnabled;
@@ -198,56 +178,7 @@ private:
 	std::string  m_infoDescription;
 	std::string  m_infoURL;
 
-	bool         m_dmrNetwork1Enabled;
-	std::string  m_dmrNetwork1Name;
-	unsigned int m_dmrNetwork1Id;
-	std::string  m_dmrNetwork1Address;
-	unsigned int m_dmrNetwork1Port;
-	unsigned int m_dmrNetwork1Local;
-	std::string  m_dmrNetwork1Password;
-	std::string  m_dmrNetwork1Options;
-	bool         m_dmrNetwork1Location;
-	bool         m_dmrNetwork1Debug;
-	std::vector<CTGRewriteStruct>   m_dmrNetwork1TGRewrites;
-	std::vector<CPCRewriteStruct>   m_dmrNetwork1PCRewrites;
-	std::vector<CTypeRewriteStruct> m_dmrNetwork1TypeRewrites;
-	std::vector<CSrcRewriteStruct>  m_dmrNetwork1SrcRewrites;
-	std::vector<unsigned int>       m_dmrNetwork1PassAllPC;
-	std::vector<unsigned int>       m_dmrNetwork1PassAllTG;
-
-	bool         m_dmrNetwork2Enabled;
-	std::string  m_dmrNetwork2Name;
-	unsigned int m_dmrNetwork2Id;
-	std::string  m_dmrNetwork2Address;
-	unsigned int m_dmrNetwork2Port;
-	unsigned int m_dmrNetwork2Local;
-	std::string  m_dmrNetwork2Password;
-	std::string  m_dmrNetwork2Options;
-	bool         m_dmrNetwork2Location;
-	bool         m_dmrNetwork2Debug;
-	std::vector<CTGRewriteStruct>   m_dmrNetwork2TGRewrites;
-	std::vector<CPCRewriteStruct>   m_dmrNetwork2PCRewrites;
-	std::vector<CTypeRewriteStruct> m_dmrNetwork2TypeRewrites;
-	std::vector<CSrcRewriteStruct>  m_dmrNetwork2SrcRewrites;
-	std::vector<unsigned int>       m_dmrNetwork2PassAllPC;
-	std::vector<unsigned int>       m_dmrNetwork2PassAllTG;
-
-	bool         m_dmrNetwork3Enabled;
-	std::string  m_dmrNetwork3Name;
-	unsigned int m_dmrNetwork3Id;
-	std::string  m_dmrNetwork3Address;
-	unsigned int m_dmrNetwork3Port;
-	unsigned int m_dmrNetwork3Local;
-	std::string  m_dmrNetwork3Password;
-	std::string  m_dmrNetwork3Options;
-	bool         m_dmrNetwork3Location;
-	bool         m_dmrNetwork3Debug;
-	std::vector<CTGRewriteStruct>   m_dmrNetwork3TGRewrites;
-	std::vector<CPCRewriteStruct>   m_dmrNetwork3PCRewrites;
-	std::vector<CTypeRewriteStruct> m_dmrNetwork3TypeRewrites;
-	std::vector<CSrcRewriteStruct>  m_dmrNetwork3SrcRewrites;
-	std::vector<unsigned int>       m_dmrNetwork3PassAllPC;
-	std::vector<unsigned int>       m_dmrNetwork3PassAllTG;
+	std::vector<CDMRNetworkStruct> m_dmrNetworks;
 
 	bool         m_xlxNetworkEnabled;
 	unsigned int m_xlxNetworkId;
@@ -264,6 +195,8 @@ private:
 	bool         m_xlxNetworkDebug;
     bool         m_xlxNetworkUserControl;
     char         m_xlxNetworkModule;
+
+	unsigned int findDMRNetwork(unsigned int number);
 };
 
 #endif
@@ -21,74 +21,27 @@
 #include <cassert>
 
 
-CDMRData::CDMRData(const CDMRData& data) :
-m_slotNo(data.m_slotNo),
-m_data(NULL),
-m_srcId(data.m_srcId),
-m_dstId(data.m_dstId),
-m_flco(data.m_flco),
-m_dataType(data.m_dataType),
-m_seqNo(data.m_seqNo),
-m_n(data.m_n),
-m_ber(data.m_ber),
-m_rssi(data.m_rssi),
-m_streamId(data.m_streamId)
-{
-	m_data = new unsigned char[2U * DMR_FRAME_LENGTH_BYTES];
-	::memcpy(m_data, data.m_data, 2U * DMR_FRAME_LENGTH_BYTES);
-}
-
 CDMRData::CDMRData() :
-m_slotNo(1U),
-m_data(NULL),
-m_srcId(0U),
-m_dstId(0U),
-m_flco(FLCO_GROUP),
+m_frame(),
 m_dataType(0U),
-m_seqNo(0U),
-m_n(0U),
-m_ber(0U),
-m_rssi(0U),
-m_streamId(0U)
-{
-	m_data = new unsigned char[2U * DMR_FRAME_LENGTH_BYTES];
-}
-
-CDMRData::~CDMRData()
-{
-	delete[] m_data;
-}
-
-CDMRData& CDMRData::operator=(const CDMRData& data)
+m_n(0U)
 {
-	if (this != &data) {
-		::memcpy(m_data, data.m_data, DMR_FRAME_LENGTH_BYTES);
+	::memcpy(m_frame.m_signature, "DMRD", 4U);
 
-		m_slotNo   = data.m_slotNo;
-		m_srcId    = data.m_srcId;
-		m_dstId    = data.m_dstId;
-		m_flco     = data.m_flco;
-		m_dataType = data.m_dataType;
-		m_seqNo    = data.m_seqNo;
-		m_n        = data.m_n;
-		m_ber      = data.m_ber;
-		m_rssi     = data.m_rssi;
-		m_streamId = data.m_streamId;
-	}
-
-	return *this;
+	setControl();
 }
 
 unsigned int CDMRData::getSlotNo() const
 {
-	return m_slotNo;
+	return (m_frame.m_control & 0x80U) == 0x80U ? 2U : 1U;
 }
 
 void CDMRData::setSlotNo(unsigned int slotNo)
 {
 	assert(slotNo == 1U || slotNo == 2U);
 
-	m_slotNo = slotNo;
+	m_frame.m_control &= 0x7FU;
+	m_frame.m_control |= slotNo == 1U ? 0x00U : 0x80U;
 }
 
 unsigned char CDMRData::getDataType() const
@@ -99,46 +52,53 @@ unsigned char CDMRData::getDataType() const
 void CDMRData::setDataType(unsigned char dataType)
 {
 	m_dataType = dataType;
+
+	setControl();
 }
 
 unsigned int CDMRData::getSrcId() const
 {
-	return m_srcId;
+	return (m_frame.m_srcId[0U] << 16) | (m_frame.m_srcId[1U] << 8) | (m_frame.m_srcId[2U] << 0);
 }
 
 void CDMRData::setSrcId(unsigned int id)
 {
-	m_srcId = id;
+	m_frame.m_srcId[0U] = id >> 16;
+	m_frame.m_srcId[1U] = id >> 8;
+	m_frame.m_srcId[2U] = id >> 0;
 }
 
 unsigned int CDMRData::getDstId() const
 {
-	return m_dstId;
+	return (m_frame.m_dstId[0U] << 16) | (m_frame.m_dstId[1U] << 8) | (m_frame.m_dstId[2U] << 0);
 }
 
 void CDMRData::setDstId(unsigned int id)
 {
-	m_dstId = id;
+	m_frame.m_dstId[0U] = id >> 16;
+	m_frame.m_dstId[1U] = id >> 8;
+	m_frame.m_dstId[2U] = id >> 0;
 }
 
 FLCO CDMRData::getFLCO() const
 {
-	return m_flco;
+	return (m_frame.m_control & 0x40U) == 0x40U ? FLCO_USER_USER : FLCO_GROUP;
 }
 
 void CDMRData::setFLCO(FLCO flco)
 {
-	m_flco = flco;
+	m_frame.m_control &= 0xBFU;
+	m_frame.m_control |= flco == FLCO_GROUP ? 0x00U : 0x40U;
 }
 
 unsigned char CDMRData::getSeqNo() const
 {
-	return m_seqNo;
+	return m_frame.m_seqNo;
 }
 
 void CDMRData::setSeqNo(unsigned char seqNo)
 {
-	m_seqNo = seqNo;
+	m_frame.m_seqNo = seqNo;
 }
 
 unsigned char CDMRData::getN() const
@@ -149,33 +109,35 @@ unsigned char CDMRData::getN() const
 void CDMRData::setN(unsigned char n)
 {
 	m_n = n;
+
+	setControl();
 }
 
 unsigned char CDMRData::getBER() const
 {
-	return m_ber;
+	return m_frame.m_ber;
 }
 
 void CDMRData::setBER(unsigned char ber)
 {
-	m_ber = ber;
+	m_frame.m_ber = ber;
 }
 
 unsigned char CDMRData::getRSSI() const
 {
-	return m_rssi;
+	return m_frame.m_rssi;
 }
 
 void CDMRData::setRSSI(unsigned char rssi)
 {
-	m_rssi = rssi;
+	m_frame.m_rssi = rssi;
 }
 
 unsigned int CDMRData::getData(unsigned char* buffer) const
 {
 	assert(buffer != NULL);
 
-	::memcpy(buffer, m_data, DMR_FRAME_LENGTH_BYTES);
+	::memcpy(buffer, m_frame.m_data, DMR_FRAME_LENGTH_BYTES);
 
 	return DMR_FRAME_LENGTH_BYTES;
 }
@@ -184,15 +146,68 @@ void CDMRData::setData(const unsigned char* buffer)
 {
 	assert(buffer != NULL);
 
-	::memcpy(m_data, buffer, DMR_FRAME_LENGTH_BYTES);
+	::memcpy(m_frame.m_data, buffer, DMR_FRAME_LENGTH_BYTES);
 }
 
 unsigned int CDMRData::getStreamId() const
 {
-	return m_streamId;
+	unsigned int id;
+	::memcpy(&id, m_frame.m_streamId, 4U);
+
+	return id;
 }
 
 void CDMRData::setStreamId(unsigned int id)
 {
-	m_streamId = id;
+	::memcpy(m_frame.m_streamId, &id, 4U);
+}
+
+bool CDMRData::setFrame(const CDMRFrame& frame)
+{
+	// Is this a data packet?
+	if (::memcmp(frame.m_signature, "DMRD", 4U) != 0)
+		return false;
+
+	::memcpy(&m_frame, &frame, sizeof(CDMRFrame));
+
+	bool dataSync  = (frame.m_control & 0x20U) == 0x20U;
+	bool voiceSync = (frame.m_control & 0x10U) == 0x10U;
+
+	if (dataSync) {
+		m_dataType = frame.m_control & 0x0FU;
+		m_n        = 0U;
+	} else if (voiceSync) {
+		m_dataType = DT_VOICE_SYNC;
+		m_n        = 0U;
+	} else {
+		m_dataType = DT_VOICE;
+		m_n        = frame.m_control & 0x0FU;
+	}
+
+	setControl();
+
+	return true;
+}
+
+void CDMRData::getFrame(CDMRFrame& frame, const unsigned char* rptId) const
+{
+	assert(rptId != NULL);
+
+	::memcpy(&frame, &m_frame, sizeof(CDMRFrame));
+
+	::memcpy(frame.m_rptId, rptId, 4U);
+}
+
+// The data type and N share the low bits of the control byte, and callers may
+// set them in either order, so both are kept and the byte is rebuilt from them
+void CDMRData::setControl()
+{
+	m_frame.m_control &= 0xC0U;
+
+	if (m_dataType == DT_VOICE_SYNC)
+		m_frame.m_control |= 0x10U;
+	else if (m_dataType == DT_VOICE)
+		m_frame.m_control |= m_n;
+	else
+		m_frame.m_control |= (0x20U | m_dataType);
 }
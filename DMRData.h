@@ -16,13 +16,29 @@
 
 #include "DMRDefines.h"
 
+// A HomeBrew DMRD packet laid out as it is on the network. It is made up only
+// of bytes so it has no padding and may be copied around with memcpy().
+struct CDMRFrame {
+	unsigned char m_signature[4U];
+	unsigned char m_seqNo;
+	unsigned char m_srcId[3U];
+	unsigned char m_dstId[3U];
+	unsigned char m_rptId[4U];
+	unsigned char m_control;
+	unsigned char m_streamId[4U];
+	unsigned char m_data[DMR_FRAME_LENGTH_BYTES];
+	unsigned char m_ber;
+	unsigned char m_rssi;
+};
+
+static_assert(sizeof(CDMRFrame) == 55U, "CDMRFrame must match the HomeBrew DMRD packet");
+
+// A typed view over a CDMRFrame. The header fields and the payload are read
+// and written in place, so receiving, rewriting and forwarding a packet only
+// touches the bytes that change.
 class CDMRData {
 public:
-	CDMRData(const CDMRData& data);
 	CDMRData();
-	~CDMRData();
-
-	CDMRData& operator=(const CDMRData& data);
 
 	unsigned int getSlotNo() const;
 	void setSlotNo(unsigned int slotNo);
@@ -57,18 +73,16 @@ public:
 	void setStreamId(unsigned int id);
 	unsigned int getStreamId() const;
 
+	// Returns false if the frame is not a DMRD packet
+	bool setFrame(const CDMRFrame& frame);
+	void getFrame(CDMRFrame& frame, const unsigned char* rptId) const;
+
 private:
-	unsigned int   m_slotNo;
-	unsigned char* m_data;
-	unsigned int   m_srcId;
-	unsigned int   m_dstId;
-	FLCO           m_flco;
+	CDMRFrame      m_frame;
 	unsigned char  m_dataType;
-	unsigned char  m_seqNo;
 	unsigned char  m_n;
-	unsigned char  m_ber;
-	unsigned char  m_rssi;
-	unsigned int   m_streamId;
+
+	void setControl();
 };
 
 #endif
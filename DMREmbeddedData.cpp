@@ -26,21 +26,36 @@
 #include <cassert>
 #include <cstring>
 
+// The LCSS that goes with each of the four fragments
+const unsigned char LCSS_TABLE[] = {1U, 3U, 3U, 2U};
+
+// Transpose an 8 x 8 bit matrix held one row per byte, the first row in the top
+// byte and the first column in the top bit of each byte
+static uint64_t transpose(uint64_t x)
+{
+	uint64_t t;
+
+	t = (x ^ (x >> 7))  & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
+
 CDMREmbeddedData::CDMREmbeddedData() :
-m_raw(NULL),
+m_raw(),
 m_state(LCS_NONE),
-m_data(NULL),
+m_data(),
 m_FLCO(FLCO_GROUP),
 m_valid(false)
 {
-	m_raw  = new bool[128U];
-	m_data = new bool[72U];
 }
 
 CDMREmbeddedData::~CDMREmbeddedData()
 {
-	delete[] m_raw;
-	delete[] m_data;
 }
 
 // Add LC data (which may consist of 4 blocks) to the data store
@@ -48,17 +63,12 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 {
 	assert(data != NULL);
 
-	bool rawData[40U];
-	CUtils::byteToBitsBE(data[14U], rawData + 0U);
-	CUtils::byteToBitsBE(data[15U], rawData + 8U);
-	CUtils::byteToBitsBE(data[16U], rawData + 16U);
-	CUtils::byteToBitsBE(data[17U], rawData + 24U);
-	CUtils::byteToBitsBE(data[18U], rawData + 32U);
+	// The 32 bits of the fragment sit between the two halves of the EMB
+	uint32_t fragment = ((data[14U] & 0x0FU) << 28) | (data[15U] << 20) | (data[16U] << 12) | (data[17U] << 4) | (data[18U] >> 4);
 
 	// Is this the first block of a 4 block embedded LC ?
 	if (lcss == 1U) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a] = rawData[a + 4U];
+		m_raw[0U] = fragment;
 
 		// Show we are ready for the next LC block
 		m_state = LCS_FIRST;
@@ -69,8 +79,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the 2nd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_FIRST) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 32U] = rawData[a + 4U];
+		m_raw[1U] = fragment;
 
 		// Show we are ready for the next LC block
 		m_state = LCS_SECOND;
@@ -80,8 +89,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the 3rd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_SECOND) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 64U] = rawData[a + 4U];
+		m_raw[2U] = fragment;
 
 		// Show we are ready for the final LC block
 		m_state = LCS_THIRD;
@@ -91,8 +99,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the final block of a 4 block embedded LC ?
 	if (lcss == 2U && m_state == LCS_THIRD)	{
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 96U] = rawData[a + 4U];
+		m_raw[3U] = fragment;
 
 		// Show that we're not ready for any more data
 		m_state = LCS_NONE;
@@ -123,47 +130,45 @@ void CDMREmbeddedData::encodeEmbeddedData()
 	unsigned int crc;
 	CCRC::encodeFiveBit(m_data, crc);
 
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	data[106U] = (crc & 0x01U) == 0x01U;
-	data[90U]  = (crc & 0x02U) == 0x02U;
-	data[74U]  = (crc & 0x04U) == 0x04U;
-	data[58U]  = (crc & 0x08U) == 0x08U;
-	data[42U]  = (crc & 0x10U) == 0x10U;
-
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		data[a] = m_data[b];
+	// The data as eight rows of sixteen bits, the first bit in the top bit of each row
+	uint16_t rows[8U];
+
+	// The first two rows take eleven bits of the LC and the rest take ten
+	rows[0U] = CUtils::getBits(m_data, 0U, 11U) << 5;
+	rows[1U] = CUtils::getBits(m_data, 11U, 11U) << 5;
+	for (unsigned int r = 2U; r < 7U; r++)
+		rows[r] = CUtils::getBits(m_data, 22U + (r - 2U) * 10U, 10U) << 6;
+
+	// The five bit CRC goes in column 10 of rows 2 to 6
+	rows[2U] |= (crc & 0x10U) << 1;
+	rows[3U] |= (crc & 0x08U) << 2;
+	rows[4U] |= (crc & 0x04U) << 3;
+	rows[5U] |= (crc & 0x02U) << 4;
+	rows[6U] |= (crc & 0x01U) << 5;
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U)
-		CHamming::encode16114(data + a);
+	for (unsigned int r = 0U; r < 7U; r++)
+		rows[r] = CHamming::encode16114(rows[r]);
 
 	// Add the parity bits for each column
-	for (unsigned int a = 0U; a < 16U; a++)
-		data[a + 112U] = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U];
-
-	// The data is packed downwards in columns
-	b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		m_raw[a] = data[b];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
+	rows[7U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U];
+
+	// The data is packed downwards in columns, one column per byte, so the
+	// fragments are the transpose of the two halves of the rows
+	uint64_t left  = 0U;
+	uint64_t right = 0U;
+	for (unsigned int r = 0U; r < 8U; r++) {
+		left  = (left  << 8) | (rows[r] >> 8);
+		right = (right << 8) | (rows[r] & 0xFFU);
 	}
+
+	left  = transpose(left);
+	right = transpose(right);
+
+	m_raw[0U] = uint32_t(left >> 32);
+	m_raw[1U] = uint32_t(left);
+	m_raw[2U] = uint32_t(right >> 32);
+	m_raw[3U] = uint32_t(right);
 }
 
 unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) const
@@ -173,31 +178,15 @@ unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) co
 	if (n >= 1U && n < 5U) {
 		n--;
 
-		bool bits[40U];
-		::memset(bits, 0x00U, 40U * sizeof(bool));
-		::memcpy(bits + 4U, m_raw + n * 32U, 32U * sizeof(bool));
-
-		unsigned char bytes[5U];
-		CUtils::bitsToByteBE(bits + 0U,  bytes[0U]);
-		CUtils::bitsToByteBE(bits + 8U,  bytes[1U]);
-		CUtils::bitsToByteBE(bits + 16U, bytes[2U]);
-		CUtils::bitsToByteBE(bits + 24U, bytes[3U]);
-		CUtils::bitsToByteBE(bits + 32U, bytes[4U]);
-
-		data[14U] = (data[14U] & 0xF0U) | (bytes[0U] & 0x0FU);
-		data[15U] = bytes[1U];
-		data[16U] = bytes[2U];
-		data[17U] = bytes[3U];
-		data[18U] = (data[18U] & 0x0FU) | (bytes[4U] & 0xF0U);
-
-		switch (n) {
-		case 0U:
-			return 1U;
-		case 3U:
-			return 2U;
-		default:
-			return 3U;
-		}
+		uint32_t fragment = m_raw[n];
+
+		data[14U] = (data[14U] & 0xF0U) | (fragment >> 28);
+		data[15U] = fragment >> 20;
+		data[16U] = fragment >> 12;
+		data[17U] = fragment >> 4;
+		data[18U] = (data[18U] & 0x0FU) | ((fragment << 4) & 0xF0U);
+
+		return LCSS_TABLE[n];
 	} else {
 		data[14U] &= 0xF0U;
 		data[15U]  = 0x00U;
@@ -212,55 +201,39 @@ unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) co
 // Unpack and error check an embedded LC
 void CDMREmbeddedData::decodeEmbeddedData()
 {
-	// The data is unpacked downwards in columns
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		data[b] = m_raw[a];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
+	// The data is unpacked downwards in columns into eight rows of sixteen bits
+	uint64_t left  = transpose((uint64_t(m_raw[0U]) << 32) | m_raw[1U]);
+	uint64_t right = transpose((uint64_t(m_raw[2U]) << 32) | m_raw[3U]);
+
+	uint16_t rows[8U];
+	for (unsigned int r = 0U; r < 8U; r++) {
+		unsigned int shift = 56U - r * 8U;
+		rows[r] = uint16_t((((left >> shift) & 0xFFU) << 8) | ((right >> shift) & 0xFFU));
 	}
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U) {
-		if (!CHamming::decode16114(data + a))
+	for (unsigned int r = 0U; r < 7U; r++) {
+		if (!CHamming::decode16114(rows[r]))
 			return;
 	}
 
 	// Check the parity bits
-	for (unsigned int a = 0U; a < 16U; a++) {
-		bool parity = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U] ^ data[a + 112U];
-		if (parity)
-			return;
-	}
+	if ((rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U] ^ rows[7U]) != 0U)
+		return;
 
 	// We have passed the Hamming check so extract the actual payload
-	b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		m_data[b] = data[a];
+	CUtils::setBits(m_data, 0U, 11U, rows[0U] >> 5);
+	CUtils::setBits(m_data, 11U, 11U, rows[1U] >> 5);
+	for (unsigned int r = 2U; r < 7U; r++)
+		CUtils::setBits(m_data, 22U + (r - 2U) * 10U, 10U, rows[r] >> 6);
 
 	// Extract the 5 bit CRC
 	unsigned int crc = 0U;
-	if (data[42])  crc += 16U;
-	if (data[58])  crc += 8U;
-	if (data[74])  crc += 4U;
-	if (data[90])  crc += 2U;
-	if (data[106]) crc += 1U;
+	crc |= (rows[2U] >> 1) & 0x10U;
+	crc |= (rows[3U] >> 2) & 0x08U;
+	crc |= (rows[4U] >> 3) & 0x04U;
+	crc |= (rows[5U] >> 4) & 0x02U;
+	crc |= (rows[6U] >> 5) & 0x01U;
 
 	// Now CRC check this
 	if (!CCRC::checkFiveBit(m_data, crc))
@@ -269,9 +242,7 @@ void CDMREmbeddedData::decodeEmbeddedData()
 	m_valid = true;
 
 	// Extract the FLCO
-	unsigned char flco;
-	CUtils::bitsToByteBE(m_data + 0U, flco);
-	m_FLCO = FLCO(flco & 0x3FU);
+	m_FLCO = FLCO(m_data[0U] & 0x3FU);
 }
 
 CDMRLC* CDMREmbeddedData::getLC() const
@@ -308,15 +279,7 @@ bool CDMREmbeddedData::getRawData(unsigned char* data) const
 	if (!m_valid)
 		return false;
 
-	CUtils::bitsToByteBE(m_data + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_data + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_data + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_data + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_data + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_data + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_data + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_data + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_data + 64U, data[8U]);
+	::memcpy(data, m_data, 9U);
 
 	return true;
 }
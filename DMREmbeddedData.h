@@ -22,6 +22,8 @@
 #include "DMRDefines.h"
 #include "DMRLC.h"
 
+#include <cstdint>
+
 enum LC_STATE {
 	LCS_NONE,
 	LCS_FIRST,
@@ -50,11 +52,11 @@ public:
 	void reset();
 
 private:
-	bool*        m_raw;
-	LC_STATE     m_state;
-	bool*        m_data;
-	FLCO         m_FLCO;
-	bool         m_valid;
+	uint32_t      m_raw[4U];
+	LC_STATE      m_state;
+	unsigned char m_data[9U];
+	FLCO          m_FLCO;
+	bool          m_valid;
 
 	void decodeEmbeddedData();
 	void encodeEmbeddedData();
@@ -27,6 +27,10 @@
 #include <cstdio>
 #include <cassert>
 
+const unsigned int CACHE_SIZE = 64U;
+
+CDMRFullLCCache CDMRFullLC::m_cache(CACHE_SIZE);
+
 CDMRFullLC::CDMRFullLC() :
 m_bptc()
 {
@@ -74,6 +78,9 @@ void CDMRFullLC::encode(const CDMRLC& lc, unsigned char* data, unsigned char typ
 	unsigned char lcData[12U];
 	lc.getData(lcData);
 
+	if (m_cache.find(lcData, type, data))
+		return;
+
 	unsigned char parity[4U];
 	CRS129::encode(lcData, 9U, parity);
 
@@ -96,4 +103,12 @@ void CDMRFullLC::encode(const CDMRLC& lc, unsigned char* data, unsigned char typ
 	}
 
 	m_bptc.encode(lcData, data);
+
+	// The key is the unencoded LC, which the parity has not touched
+	m_cache.add(lcData, type, data);
+}
+
+const CDMRFullLCCache& CDMRFullLC::getCache()
+{
+	return m_cache;
 }
@@ -21,6 +21,7 @@
 
 #include "DMRLC.h"
 #include "DMRSlotType.h"
+#include "DMRFullLCCache.h"
 
 #include "BPTC19696.h"
 
@@ -34,8 +35,13 @@ public:
 
 	void encode(const CDMRLC& lc, unsigned char* data, unsigned char type);
 
+	// The encoded LCs are shared by every instance, which must all be on the same thread
+	static const CDMRFullLCCache& getCache();
+
 private:
 	CBPTC19696 m_bptc;
+
+	static CDMRFullLCCache m_cache;
 };
 
 #endif
@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "DMRFullLCCache.h"
+
+#include <cstdio>
+#include <cassert>
+
+const unsigned int NO_ENTRY = 0xFFFFFFFFU;
+
+CDMRFullLCCache::CDMRFullLCCache(unsigned int size) :
+m_entries(),
+m_index(),
+m_size(size),
+m_head(NO_ENTRY),
+m_tail(NO_ENTRY),
+m_hits(0U),
+m_misses(0U)
+{
+	assert(size > 0U);
+
+	m_entries.reserve(size);
+}
+
+CDMRFullLCCache::~CDMRFullLCCache()
+{
+}
+
+bool CDMRFullLCCache::find(const unsigned char* lc, unsigned char type, unsigned char* data)
+{
+	assert(lc != NULL);
+	assert(data != NULL);
+
+	std::map<CKey, unsigned int>::const_iterator it = m_index.find(getKey(lc, type));
+	if (it == m_index.end()) {
+		m_misses++;
+		return false;
+	}
+
+	m_hits++;
+
+	unsigned int n = it->second;
+	if (n != m_head) {
+		unlink(n);
+		pushFront(n);
+	}
+
+	// Copy the BPTC(196,96) bits around the slot type and sync
+	const unsigned char* entry = m_entries[n].m_data;
+	for (unsigned int i = 0U; i < 12U; i++)
+		data[i] = entry[i];
+	data[12U] = (data[12U] & 0x3FU) | (entry[12U] & 0xC0U);
+	data[20U] = (data[20U] & 0xFCU) | (entry[20U] & 0x03U);
+	for (unsigned int i = 21U; i < 33U; i++)
+		data[i] = entry[i];
+
+	return true;
+}
+
+void CDMRFullLCCache::add(const unsigned char* lc, unsigned char type, const unsigned char* data)
+{
+	assert(lc != NULL);
+	assert(data != NULL);
+
+	CKey key = getKey(lc, type);
+	if (m_index.count(key) > 0U)
+		return;
+
+	unsigned int n;
+	if (m_entries.size() < m_size) {
+		n = (unsigned int)m_entries.size();
+		m_entries.push_back(CEntry());
+	} else {
+		// Reuse the least recently used entry
+		n = m_tail;
+		unlink(n);
+		m_index.erase(m_entries[n].m_key);
+	}
+
+	CEntry& entry = m_entries[n];
+	entry.m_key = key;
+	for (unsigned int i = 0U; i < 33U; i++)
+		entry.m_data[i] = data[i];
+
+	m_index[key] = n;
+	pushFront(n);
+}
+
+unsigned int CDMRFullLCCache::getHits() const
+{
+	return m_hits;
+}
+
+unsigned int CDMRFullLCCache::getMisses() const
+{
+	return m_misses;
+}
+
+CDMRFullLCCache::CKey CDMRFullLCCache::getKey(const unsigned char* lc, unsigned char type) const
+{
+	uint64_t value = 0U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		value = (value << 8) | lc[i];
+
+	return CKey(value, (lc[8U] << 8) | type);
+}
+
+void CDMRFullLCCache::unlink(unsigned int n)
+{
+	CEntry& entry = m_entries[n];
+
+	if (entry.m_prev != NO_ENTRY)
+		m_entries[entry.m_prev].m_next = entry.m_next;
+	else
+		m_head = entry.m_next;
+
+	if (entry.m_next != NO_ENTRY)
+		m_entries[entry.m_next].m_prev = entry.m_prev;
+	else
+		m_tail = entry.m_prev;
+}
+
+void CDMRFullLCCache::pushFront(unsigned int n)
+{
+	CEntry& entry = m_entries[n];
+
+	entry.m_prev = NO_ENTRY;
+	entry.m_next = m_head;
+
+	if (m_head != NO_ENTRY)
+		m_entries[m_head].m_prev = n;
+	else
+		m_tail = n;
+
+	m_head = n;
+}
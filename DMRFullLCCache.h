@@ -0,0 +1,68 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRFullLCCache_H)
+#define	DMRFullLCCache_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <map>
+
+// A least recently used cache of encoded full LCs, keyed on the nine bytes of
+// the LC and the data type. Only the BPTC(196,96) part of the burst is kept,
+// the slot type and sync are always those already in the burst.
+class CDMRFullLCCache
+{
+public:
+	CDMRFullLCCache(unsigned int size);
+	~CDMRFullLCCache();
+
+	bool find(const unsigned char* lc, unsigned char type, unsigned char* data);
+
+	void add(const unsigned char* lc, unsigned char type, const unsigned char* data);
+
+	unsigned int getHits() const;
+	unsigned int getMisses() const;
+
+private:
+	typedef std::pair<uint64_t, unsigned int> CKey;
+
+	struct CEntry {
+		CKey          m_key;
+		unsigned char m_data[33U];
+		unsigned int  m_prev;
+		unsigned int  m_next;
+	};
+
+	std::vector<CEntry>          m_entries;
+	std::map<CKey, unsigned int> m_index;
+	unsigned int                 m_size;
+	unsigned int                 m_head;
+	unsigned int                 m_tail;
+	unsigned int                 m_hits;
+	unsigned int                 m_misses;
+
+	CKey getKey(const unsigned char* lc, unsigned char type) const;
+
+	void unlink(unsigned int n);
+	void pushFront(unsigned int n);
+};
+
+#endif
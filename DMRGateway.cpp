@@ -26,7 +26,7 @@
 #include "PassAllTG.h"
 #include "DMRFullLC.h"
 #include "Version.h"
-#include "Thread.h"
+#include "Poller.h"
 #include "DMRLC.h"
 #include "Voice.h"
 #include "Sync.h"
@@ -35,6 +35,8 @@
 
 #include <cstdio>
 #include <vector>
+#include <cstring>
+#include <cassert>
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <sys/types.h>
@@ -55,6 +57,12 @@ const unsigned int XLX_TG   = 9U;
 
 const unsigned char COLOR_CODE = 3U;
 
+// The longest that the main loop will wait for network traffic
+const unsigned int MAX_WAIT_TIME = 1000U;
+
+// How long in seconds before a host name that can't be found is tried again
+const unsigned int DNS_RETRY_TIME = 30U;
+
 static bool m_killed = false;
 static int  m_signal = 0;
 
@@ -66,13 +74,10 @@ static void sigHandler(int signum)
 }
 #endif
 
-enum DMRGW_STATUS {
-	DMRGWS_NONE,
-	DMRGWS_DMRNETWORK1,
-	DMRGWS_DMRNETWORK2,
-	DMRGWS_DMRNETWORK3,
-	DMRGWS_XLXREFLECTOR
-};
+// A slot is owned by nobody, the XLX reflector, or a DMR network given by
+// its position in m_dmrNetworks plus one, as returned by the routing tables
+const unsigned int DMRGWS_NONE         = 0U;
+const unsigned int DMRGWS_XLXREFLECTOR = 0xFFFFFFFFU;
 
 const char* HEADER1 = "This software is for use on amateur radio networks only,";
 const char* HEADER2 = "it is to be used for educational purposes only. Its use on";
@@ -134,12 +139,11 @@ m_conf(confFile),
 m_repeater(NULL),
 m_config(NULL),
 m_configLen(0U),
-m_dmrNetwork1(NULL),
-m_dmr1Name(),
-m_dmrNetwork2(NULL),
-m_dmr2Name(),
-m_dmrNetwork3(NULL),
-m_dmr3Name(),
+m_budget(1U),
+m_threaded(false),
+m_poller(),
+m_resolver(NULL),
+m_dmrNetworks(),
 m_xlxReflectors(NULL),
 m_xlxNetwork(NULL),
 m_xlxId(0U),
@@ -160,47 +164,25 @@ m_xlxUserControl(true),
 m_xlxModule(),
 m_rptRewrite(NULL),
 m_xlxRewrite(NULL),
-m_dmr1NetRewrites(),
-m_dmr1RFRewrites(),
-m_dmr2NetRewrites(),
-m_dmr2RFRewrites(),
-m_dmr3NetRewrites(),
-m_dmr3RFRewrites(),
-m_dmr1Passalls(),
-m_dmr2Passalls(),
-m_dmr3Passalls()
+m_rfRoutes()
 {
 	m_config = new unsigned char[400U];
 }
 
 CDMRGateway::~CDMRGateway()
 {
-	for (std::vector<CRewrite*>::iterator it = m_dmr1NetRewrites.begin(); it != m_dmr1NetRewrites.end(); ++it)
-		delete *it;
-
-	for (std::vector<CRewrite*>::iterator it = m_dmr1RFRewrites.begin(); it != m_dmr1RFRewrites.end(); ++it)
-		delete *it;
-
-	for (std::vector<CRewrite*>::iterator it = m_dmr2NetRewrites.begin(); it != m_dmr2NetRewrites.end(); ++it)
-			delete *it;
-	
-	for (std::vector<CRewrite*>::iterator it = m_dmr2RFRewrites.begin(); it != m_dmr2RFRewrites.end(); ++it)
-			delete *it;
+	for (std::vector<CDMRGatewayNetwork*>::iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it) {
+		for (std::vector<CRewrite*>::iterator it2 = (*it)->m_netRewrites.begin(); it2 != (*it)->m_netRewrites.end(); ++it2)
+			delete *it2;
 
-	for (std::vector<CRewrite*>::iterator it = m_dmr3NetRewrites.begin(); it != m_dmr3NetRewrites.end(); ++it)
-		delete *it;
-
-	for (std::vector<CRewrite*>::iterator it = m_dmr3RFRewrites.begin(); it != m_dmr3RFRewrites.end(); ++it)
-		delete *it;
-
-	for (std::vector<CRewrite*>::iterator it = m_dmr1Passalls.begin(); it != m_dmr1Passalls.end(); ++it)
-		delete *it;
+		for (std::vector<CRewrite*>::iterator it2 = (*it)->m_rfRewrites.begin(); it2 != (*it)->m_rfRewrites.end(); ++it2)
+			delete *it2;
 
-	for (std::vector<CRewrite*>::iterator it = m_dmr2Passalls.begin(); it != m_dmr2Passalls.end(); ++it)
-		delete *it;
+		for (std::vector<CRewrite*>::iterator it2 = (*it)->m_passalls.begin(); it2 != (*it)->m_passalls.end(); ++it2)
+			delete *it2;
 
-	for (std::vector<CRewrite*>::iterator it = m_dmr3Passalls.begin(); it != m_dmr3Passalls.end(); ++it)
 		delete *it;
+	}
 
 	delete m_rptRewrite;
 	delete m_xlxRewrite;
@@ -293,10 +275,21 @@ int CDMRGateway::run()
 	LogMessage("DMRGateway-%s is starting", VERSION);
 	LogMessage("Built %s %s (GitID #%.7s)", __TIME__, __DATE__, gitversion);
 
+	m_budget = m_conf.getPacketBudget();
+	if (m_budget == 0U)
+		m_budget = 1U;
+
 	ret = createMMDVM();
 	if (!ret)
 		return 1;
 
+	ret = m_poller.open();
+	if (!ret) {
+		m_repeater->close();
+		delete m_repeater;
+		return 1;
+	}
+
 	LogMessage("Waiting for MMDVM to connect.....");
 
 	while (!m_killed) {
@@ -304,38 +297,50 @@ int CDMRGateway::run()
 		if (m_configLen > 0U && m_repeater->getId() > 1000U)
 			break;
 
-		m_repeater->clock(10U);
+		m_repeater->flush();
+
+		int fd = m_repeater->getFd();
+		m_poller.wait(&fd, 1U, m_repeater->getDeadline(MAX_WAIT_TIME));
 
-		CThread::sleep(10U);
+		m_repeater->clock(10U);
 	}
 
 	if (m_killed) {
 		m_repeater->close();
 		delete m_repeater;
+		m_poller.close();
 		return 0;
 	}
 
 	LogMessage("MMDVM has connected");
 
+	m_threaded = m_conf.getThreaded();
+	if (m_threaded)
+		m_repeater->startThread(&m_poller);
+
 	bool ruleTrace = m_conf.getRuleTrace();
 	LogInfo("Rule trace: %s", ruleTrace ? "yes" : "no");
+	LogInfo("Packet budget: %u", m_budget);
+	LogInfo("Threaded: %s", m_threaded ? "yes" : "no");
 
-	if (m_conf.getDMRNetwork1Enabled()) {
-		ret = createDMRNetwork1();
-		if (!ret)
-			return 1;
-	}
+	unsigned int dnsRefresh = m_conf.getDNSRefresh();
+	if (dnsRefresh == 0U)
+		dnsRefresh = 1U;
 
-	if (m_conf.getDMRNetwork2Enabled()) {
-		ret = createDMRNetwork2();
-		if (!ret)
-			return 1;
-	}
+	LogInfo("DNS refresh: %us", dnsRefresh);
 
-	if (m_conf.getDMRNetwork3Enabled()) {
-		ret = createDMRNetwork3();
-		if (!ret)
-			return 1;
+	m_resolver = new CResolver(dnsRefresh, DNS_RETRY_TIME);
+	ret = m_resolver->start();
+	if (!ret)
+		return 1;
+
+	std::vector<CDMRNetworkStruct> dmrNetworks = m_conf.getDMRNetworks();
+	for (std::vector<CDMRNetworkStruct>::const_iterator it = dmrNetworks.begin(); it != dmrNetworks.end(); ++it) {
+		if ((*it).m_enabled) {
+			ret = createDMRNetwork(*it);
+			if (!ret)
+				return 1;
+		}
 	}
 
 	if (m_conf.getXLXNetworkEnabled()) {
@@ -344,6 +349,8 @@ int CDMRGateway::run()
 			return 1;
 	}
 
+	createRoutingTables();
+
 	unsigned int rfTimeout  = m_conf.getRFTimeout();
 	unsigned int netTimeout = m_conf.getNetTimeout();
 
@@ -369,7 +376,7 @@ int CDMRGateway::run()
 	timer[1U] = new CTimer(1000U);
 	timer[2U] = new CTimer(1000U);
 
-	DMRGW_STATUS status[3U];
+	unsigned int status[3U];
 	status[1U] = DMRGWS_NONE;
 	status[2U] = DMRGWS_NONE;
 
@@ -377,24 +384,50 @@ int CDMRGateway::run()
 	unsigned int rfDstId[3U];
 	rfSrcId[1U] = rfSrcId[2U] = rfDstId[1U] = rfDstId[2U] = 0U;
 
-	unsigned int dmr1SrcId[3U];
-	unsigned int dmr1DstId[3U];
-	dmr1SrcId[1U] = dmr1SrcId[2U] = dmr1DstId[1U] = dmr1DstId[2U] = 0U;
-
-	unsigned int dmr2SrcId[3U];
-	unsigned int dmr2DstId[3U];
-	dmr2SrcId[1U] = dmr2SrcId[2U] = dmr2DstId[1U] = dmr2DstId[2U] = 0U;
-
-	unsigned int dmr3SrcId[3U];
-	unsigned int dmr3DstId[3U];
-	dmr3SrcId[1U] = dmr3SrcId[2U] = dmr3DstId[1U] = dmr3DstId[2U] = 0U;
+	// The MMDVM, each of the DMR networks, then XLX
+	std::vector<int> fds(m_dmrNetworks.size() + 2U);
 
 	CStopWatch stopWatch;
 	stopWatch.start();
 
 	LogMessage("DMRGateway-%s is running", VERSION);
 
+	unsigned int lastTime = 0U;
+
 	while (!m_killed) {
+		// Use the running total so that partial milliseconds are not lost between wake ups
+		unsigned int elapsed = stopWatch.elapsed();
+		unsigned int ms = elapsed - lastTime;
+		lastTime = elapsed;
+
+		m_repeater->clock(ms);
+
+		m_xlxRelink.clock(ms);
+
+		for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+			(*it)->m_network->clock(ms);
+
+		if (m_xlxNetwork != NULL)
+			m_xlxNetwork->clock(ms);
+
+		if (m_xlxReflectors != NULL)
+			m_xlxReflectors->clock(ms);
+
+		if (voice != NULL)
+			voice->clock(ms);
+
+		m_rfRoutes.clock(ms);
+		for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+			(*it)->m_netRoutes.clock(ms);
+
+		for (unsigned int i = 1U; i < 3U; i++) {
+			timer[i]->clock(ms);
+			if (timer[i]->isRunning() && timer[i]->hasExpired()) {
+				status[i] = DMRGWS_NONE;
+				timer[i]->stop();
+			}
+		}
+
 		if (m_xlxNetwork != NULL) {
 			bool connected = m_xlxNetwork->isConnected();
 			if (connected && !m_xlxConnected) {
@@ -469,8 +502,7 @@ int CDMRGateway::run()
 
 		CDMRData data;
 
-		bool ret = m_repeater->read(data);
-		if (ret) {
+		for (unsigned int n = 0U; n < m_budget && m_repeater->read(data); n++) {
 			unsigned int slotNo = data.getSlotNo();
 			unsigned int srcId = data.getSrcId();
 			unsigned int dstId = data.getDstId();
@@ -549,143 +581,25 @@ int CDMRGateway::run()
 				if (trace)
 					LogDebug("Rule Trace, RF transmission: Slot=%u Src=%u Dst=%s%u", slotNo, srcId, flco == FLCO_GROUP ? "TG" : "", dstId);
 
-				bool rewritten = false;
-
-				if (m_dmrNetwork1 != NULL) {
-					// Rewrite the slot and/or TG or neither
-					for (std::vector<CRewrite*>::iterator it = m_dmr1RFRewrites.begin(); it != m_dmr1RFRewrites.end(); ++it) {
-						bool ret = (*it)->process(data, trace);
-						if (ret) {
-							rewritten = true;
-							break;
-						}
-					}
-
-					if (rewritten) {
-						if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK1) {
-							m_dmrNetwork1->write(data);
-							status[slotNo] = DMRGWS_DMRNETWORK1;
-							timer[slotNo]->setTimeout(rfTimeout);
-							timer[slotNo]->start();
-						}
-					}
-				}
-
-				if (!rewritten) {
-					if (m_dmrNetwork2 != NULL) {
-						// Rewrite the slot and/or TG or neither
-						for (std::vector<CRewrite*>::iterator it = m_dmr2RFRewrites.begin(); it != m_dmr2RFRewrites.end(); ++it) {
-							bool ret = (*it)->process(data, trace);
-							if (ret) {
-								rewritten = true;
-								break;
-							}
-						}
-
-						if (rewritten) {
-							if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK2) {
-								m_dmrNetwork2->write(data);
-								status[slotNo] = DMRGWS_DMRNETWORK2;
-								timer[slotNo]->setTimeout(rfTimeout);
-								timer[slotNo]->start();
-							}
-						}
-					}
-
-					if (!rewritten) {
-						if (m_dmrNetwork3 != NULL) {
-							// Rewrite the slot and/or TG or neither
-							for (std::vector<CRewrite*>::iterator it = m_dmr3RFRewrites.begin(); it != m_dmr3RFRewrites.end(); ++it) {
-								bool ret = (*it)->process(data, trace);
-								if (ret) {
-									rewritten = true;
-									break;
-								}
-							}
-
-							if (rewritten) {
-								if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK3) {
-									m_dmrNetwork3->write(data);
-									status[slotNo] = DMRGWS_DMRNETWORK3;
-									timer[slotNo]->setTimeout(rfTimeout);
-									timer[slotNo]->start();
-								}
-							}
-						}
-					}
-				}
-
-				if (!rewritten) {
-					if (m_dmrNetwork1 != NULL) {
-						for (std::vector<CRewrite*>::iterator it = m_dmr1Passalls.begin(); it != m_dmr1Passalls.end(); ++it) {
-							bool ret = (*it)->process(data, trace);
-							if (ret) {
-								rewritten = true;
-								break;
-							}
-						}
-
-						if (rewritten) {
-							if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK1) {
-								m_dmrNetwork1->write(data);
-								status[slotNo] = DMRGWS_DMRNETWORK1;
-								timer[slotNo]->setTimeout(rfTimeout);
-								timer[slotNo]->start();
-							}
-						}
-					}
-				}
-
-				if (!rewritten) {
-					if (m_dmrNetwork2 != NULL) {
-						for (std::vector<CRewrite*>::iterator it = m_dmr2Passalls.begin(); it != m_dmr2Passalls.end(); ++it) {
-							bool ret = (*it)->process(data, trace);
-							if (ret) {
-								rewritten = true;
-								break;
-							}
-						}
-
-						if (rewritten) {
-							if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK2) {
-								m_dmrNetwork2->write(data);
-								status[slotNo] = DMRGWS_DMRNETWORK2;
-								timer[slotNo]->setTimeout(rfTimeout);
-								timer[slotNo]->start();
-							}
-						}
-					}
-				}
-
-				if (!rewritten) {
-					if (m_dmrNetwork3 != NULL) {
-						for (std::vector<CRewrite*>::iterator it = m_dmr3Passalls.begin(); it != m_dmr3Passalls.end(); ++it) {
-							bool ret = (*it)->process(data, trace);
-							if (ret) {
-								rewritten = true;
-								break;
-							}
-						}
+				// Rewrite the slot and/or TG or neither
+				unsigned int network = m_rfRoutes.process(data, trace);
 
-						if (rewritten) {
-							if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK3) {
-								m_dmrNetwork3->write(data);
-								status[slotNo] = DMRGWS_DMRNETWORK3;
-								timer[slotNo]->setTimeout(rfTimeout);
-								timer[slotNo]->start();
-							}
-						}
+				if (network != 0U) {
+					if (status[slotNo] == DMRGWS_NONE || status[slotNo] == network) {
+						m_dmrNetworks[network - 1U]->m_network->write(data);
+						status[slotNo] = network;
+						timer[slotNo]->setTimeout(rfTimeout);
+						timer[slotNo]->start();
 					}
 				}
 
-				if (!rewritten && trace)
+				if (network == 0U && trace)
 					LogDebug("Rule Trace,\tnot matched so rejected");
 			}
 		}
 
 		if (m_xlxNetwork != NULL) {
-			ret = m_xlxNetwork->read(data);
-			if (ret) {
+			for (unsigned int n = 0U; n < m_budget && m_xlxNetwork->read(data); n++) {
 				if (status[m_xlxSlot] == DMRGWS_NONE || status[m_xlxSlot] == DMRGWS_XLXREFLECTOR) {
 					bool ret = m_rptRewrite->process(data, false);
 					if (ret) {
@@ -703,136 +617,35 @@ int CDMRGateway::run()
 			}
 		}
 
-		if (m_dmrNetwork1 != NULL) {
-			ret = m_dmrNetwork1->read(data);
-			if (ret) {
-				unsigned int slotNo = data.getSlotNo();
-				unsigned int srcId  = data.getSrcId();
-				unsigned int dstId  = data.getDstId();
-				FLCO flco           = data.getFLCO();
-
-				bool trace = false;
-				if (ruleTrace && (srcId != dmr1SrcId[slotNo] || dstId != dmr1DstId[slotNo])) {
-					dmr1SrcId[slotNo] = srcId;
-					dmr1DstId[slotNo] = dstId;
-					trace = true;
-				}
-
-				if (trace)
-					LogDebug("Rule Trace, network 1 transmission: Slot=%u Src=%u Dst=%s%u", slotNo, srcId, flco == FLCO_GROUP ? "TG" : "", dstId);
-
-				// Rewrite the slot and/or TG or neither
-				bool rewritten = false;
-				for (std::vector<CRewrite*>::iterator it = m_dmr1NetRewrites.begin(); it != m_dmr1NetRewrites.end(); ++it) {
-					bool ret = (*it)->process(data, trace);
-					if (ret) {
-						rewritten = true;
-						break;
-					}
-				}
-
-				if (rewritten) {
-					// Check that the rewritten slot is free to use.
-					slotNo = data.getSlotNo();
-					if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK1) {
-						m_repeater->write(data);
-						status[slotNo] = DMRGWS_DMRNETWORK1;
-						timer[slotNo]->setTimeout(netTimeout);
-						timer[slotNo]->start();
-					}
-				}
-
-				if (!rewritten && trace)
-					LogDebug("Rule Trace,\tnot matched so rejected");
-			}
-
-			ret = m_dmrNetwork1->wantsBeacon();
-			if (ret)
-				m_repeater->writeBeacon();
-		}
+		for (unsigned int i = 0U; i < m_dmrNetworks.size(); i++) {
+			CDMRGatewayNetwork* dmrNetwork = m_dmrNetworks[i];
+			unsigned int network = i + 1U;
 
-		if (m_dmrNetwork2 != NULL) {
-			ret = m_dmrNetwork2->read(data);
-			if (ret) {
+			for (unsigned int n = 0U; n < m_budget && dmrNetwork->m_network->read(data); n++) {
 				unsigned int slotNo = data.getSlotNo();
 				unsigned int srcId  = data.getSrcId();
 				unsigned int dstId  = data.getDstId();
 				FLCO flco           = data.getFLCO();
 
 				bool trace = false;
-				if (ruleTrace && (srcId != dmr2SrcId[slotNo] || dstId != dmr2DstId[slotNo])) {
-					dmr2SrcId[slotNo] = srcId;
-					dmr2DstId[slotNo] = dstId;
-					trace = true;
-				}
-
-				if (trace)
-					LogDebug("Rule Trace, network 2 transmission: Slot=%u Src=%u Dst=%s%u", slotNo, srcId, flco == FLCO_GROUP ? "TG" : "", dstId);
-
-				// Rewrite the slot and/or TG or neither
-				bool rewritten = false;
-				for (std::vector<CRewrite*>::iterator it = m_dmr2NetRewrites.begin(); it != m_dmr2NetRewrites.end(); ++it) {
-					bool ret = (*it)->process(data, trace);
-					if (ret) {
-						rewritten = true;
-						break;
-					}
-				}
-
-				if (rewritten) {
-					// Check that the rewritten slot is free to use.
-					slotNo = data.getSlotNo();
-					if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK2) {
-						m_repeater->write(data);
-						status[slotNo] = DMRGWS_DMRNETWORK2;
-						timer[slotNo]->setTimeout(netTimeout);
-						timer[slotNo]->start();
-					}
-				}
-
-				if (!rewritten && trace)
-					LogDebug("Rule Trace,\tnot matched so rejected");
-			}
-
-			ret = m_dmrNetwork2->wantsBeacon();
-			if (ret)
-				m_repeater->writeBeacon();
-		}
-
-		if (m_dmrNetwork3 != NULL) {
-			ret = m_dmrNetwork3->read(data);
-			if (ret) {
-				unsigned int slotNo = data.getSlotNo();
-				unsigned int srcId = data.getSrcId();
-				unsigned int dstId = data.getDstId();
-				FLCO flco = data.getFLCO();
-
-				bool trace = false;
-				if (ruleTrace && (srcId != dmr3SrcId[slotNo] || dstId != dmr3DstId[slotNo])) {
-					dmr3SrcId[slotNo] = srcId;
-					dmr3DstId[slotNo] = dstId;
+				if (ruleTrace && (srcId != dmrNetwork->m_srcId[slotNo] || dstId != dmrNetwork->m_dstId[slotNo])) {
+					dmrNetwork->m_srcId[slotNo] = srcId;
+					dmrNetwork->m_dstId[slotNo] = dstId;
 					trace = true;
 				}
 
 				if (trace)
-					LogDebug("Rule Trace, network 3 transmission: Slot=%u Src=%u Dst=%s%u", slotNo, srcId, flco == FLCO_GROUP ? "TG" : "", dstId);
+					LogDebug("Rule Trace, network %u transmission: Slot=%u Src=%u Dst=%s%u", dmrNetwork->m_number, slotNo, srcId, flco == FLCO_GROUP ? "TG" : "", dstId);
 
 				// Rewrite the slot and/or TG or neither
-				bool rewritten = false;
-				for (std::vector<CRewrite*>::iterator it = m_dmr3NetRewrites.begin(); it != m_dmr3NetRewrites.end(); ++it) {
-					bool ret = (*it)->process(data, trace);
-					if (ret) {
-						rewritten = true;
-						break;
-					}
-				}
+				bool rewritten = dmrNetwork->m_netRoutes.process(data, trace) != 0U;
 
 				if (rewritten) {
 					// Check that the rewritten slot is free to use.
 					slotNo = data.getSlotNo();
-					if (status[slotNo] == DMRGWS_NONE || status[slotNo] == DMRGWS_DMRNETWORK3) {
+					if (status[slotNo] == DMRGWS_NONE || status[slotNo] == network) {
 						m_repeater->write(data);
-						status[slotNo] = DMRGWS_DMRNETWORK3;
+						status[slotNo] = network;
 						timer[slotNo]->setTimeout(netTimeout);
 						timer[slotNo]->start();
 					}
@@ -842,7 +655,7 @@ int CDMRGateway::run()
 					LogDebug("Rule Trace,\tnot matched so rejected");
 			}
 
-			ret = m_dmrNetwork3->wantsBeacon();
+			ret = dmrNetwork->m_network->wantsBeacon();
 			if (ret)
 				m_repeater->writeBeacon();
 		}
@@ -853,34 +666,22 @@ int CDMRGateway::run()
 		if (ret) {
 			if (m_xlxNetwork != NULL)
 				m_xlxNetwork->writeRadioPosition(buffer, length);
-			if (m_dmrNetwork1 != NULL)
-				m_dmrNetwork1->writeRadioPosition(buffer, length);
-			if (m_dmrNetwork2 != NULL)
-				m_dmrNetwork2->writeRadioPosition(buffer, length);
-			if (m_dmrNetwork3 != NULL)
-				m_dmrNetwork3->writeRadioPosition(buffer, length);
+			for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+				(*it)->m_network->writeRadioPosition(buffer, length);
 		}
 		ret = m_repeater->readTalkerAlias(buffer, length);
 		if (ret) {
 			if (m_xlxNetwork != NULL)
 				m_xlxNetwork->writeTalkerAlias(buffer, length);
-			if (m_dmrNetwork1 != NULL)
-				m_dmrNetwork1->writeTalkerAlias(buffer, length);
-			if (m_dmrNetwork2 != NULL)
-				m_dmrNetwork2->writeTalkerAlias(buffer, length);
-			if (m_dmrNetwork3 != NULL)
-				m_dmrNetwork3->writeTalkerAlias(buffer, length);
+			for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+				(*it)->m_network->writeTalkerAlias(buffer, length);
 		}
 		ret = m_repeater->readHomePosition(buffer, length);
 		if (ret) {
 			if (m_xlxNetwork != NULL)
 				m_xlxNetwork->writeHomePosition(buffer, length);
-			if (m_dmrNetwork1 != NULL)
-				m_dmrNetwork1->writeHomePosition(buffer, length);
-			if (m_dmrNetwork2 != NULL)
-				m_dmrNetwork2->writeHomePosition(buffer, length);
-			if (m_dmrNetwork3 != NULL)
-				m_dmrNetwork3->writeHomePosition(buffer, length);
+			for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+				(*it)->m_network->writeHomePosition(buffer, length);
 		}
 
 		if (voice != NULL) {
@@ -893,61 +694,56 @@ int CDMRGateway::run()
 			}
 		}
 
-		unsigned int ms = stopWatch.elapsed();
-		stopWatch.start();
+		// Send everything written during this pass, one batch per socket
+		m_repeater->flush();
 
-		m_repeater->clock(ms);
+		for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+			(*it)->m_network->flush();
 
-		m_xlxRelink.clock(ms);
+		if (m_xlxNetwork != NULL)
+			m_xlxNetwork->flush();
 
-		if (m_dmrNetwork1 != NULL)
-			m_dmrNetwork1->clock(ms);
+		// Sleep until there is network traffic or the next timer is due
+		unsigned int timeout = m_repeater->getDeadline(MAX_WAIT_TIME);
 
-		if (m_dmrNetwork2 != NULL)
-			m_dmrNetwork2->clock(ms);
+		timeout = m_xlxRelink.getDeadline(timeout);
 
-		if (m_dmrNetwork3 != NULL)
-			m_dmrNetwork3->clock(ms);
+		for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+			timeout = (*it)->m_network->getDeadline(timeout);
 
 		if (m_xlxNetwork != NULL)
-			m_xlxNetwork->clock(ms);
+			timeout = m_xlxNetwork->getDeadline(timeout);
 
 		if (m_xlxReflectors != NULL)
-			m_xlxReflectors->clock(ms);
+			timeout = m_xlxReflectors->getDeadline(timeout);
 
 		if (voice != NULL)
-			voice->clock(ms);
+			timeout = voice->getDeadline(timeout);
 
-		for (unsigned int i = 1U; i < 3U; i++) {
-			timer[i]->clock(ms);
-			if (timer[i]->isRunning() && timer[i]->hasExpired()) {
-				status[i] = DMRGWS_NONE;
-				timer[i]->stop();
-			}
-		}
+		for (unsigned int i = 1U; i < 3U; i++)
+			timeout = timer[i]->getDeadline(timeout);
 
-		if (ms < 10U)
-			CThread::sleep(10U);
+		unsigned int nFds = 0U;
+		fds[nFds++] = m_repeater->getFd();
+		for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+			fds[nFds++] = (*it)->m_network->getFd();
+		fds[nFds++] = m_xlxNetwork != NULL ? m_xlxNetwork->getFd() : -1;
+
+		m_poller.wait(&fds[0U], nFds, timeout);
 	}
 
+	const CDMRFullLCCache& cache = CDMRFullLC::getCache();
+	LogMessage("Full LC cache, %u hits, %u misses", cache.getHits(), cache.getMisses());
+	LogMessage("CSBK and data header rewrites, %u re-encoded, %u unchanged", CRewrite::getRewritten(), CRewrite::getUnchanged());
+
 	delete voice;
 
 	m_repeater->close();
 	delete m_repeater;
 
-	if (m_dmrNetwork1 != NULL) {
-		m_dmrNetwork1->close();
-		delete m_dmrNetwork1;
-	}
-
-	if (m_dmrNetwork2 != NULL) {
-		m_dmrNetwork2->close();
-		delete m_dmrNetwork2;
-	}
-
-	if (m_dmrNetwork3 != NULL) {
-		m_dmrNetwork3->close();
-		delete m_dmrNetwork3;
+	for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it) {
+		(*it)->m_network->close();
+		delete (*it)->m_network;
 	}
 
 	if (m_xlxNetwork != NULL) {
@@ -960,6 +756,11 @@ int CDMRGateway::run()
 
 	delete m_xlxReflectors;
 
+	m_resolver->stop();
+	delete m_resolver;
+
+	m_poller.close();
+
 	return 0;
 }
 
@@ -970,14 +771,23 @@ bool CDMRGateway::createMMDVM()
 	std::string localAddress = m_conf.getLocalAddress();
 	unsigned int localPort   = m_conf.getLocalPort();
 	bool debug               = m_conf.getDebug();
+	unsigned int playout     = m_conf.getPlayoutDepth();
+	bool dropOldest          = m_conf.getPlayoutDropOldest();
 
 	LogInfo("MMDVM Network Parameters");
 	LogInfo("    Rpt Address: %s", rptAddress.c_str());
 	LogInfo("    Rpt Port: %u", rptPort);
 	LogInfo("    Local Address: %s", localAddress.c_str());
 	LogInfo("    Local Port: %u", localPort);
+	if (playout > 0U)
+		LogInfo("    Playout: %u frames a slot, dropping %s frames", playout, dropOldest ? "old" : "new");
+	else
+		LogInfo("    Playout: disabled");
+
+	CMMDVMNetwork* repeater = new CMMDVMNetwork(rptAddress, rptPort, localAddress, localPort, m_budget, debug);
+	repeater->setPlayout(playout, dropOldest ? FQO_DROP_OLDEST : FQO_DROP_NEWEST);
 
-	m_repeater = new CMMDVMNetwork(rptAddress, rptPort, localAddress, localPort, debug);
+	m_repeater = repeater;
 
 	bool ret = m_repeater->open();
 	if (!ret) {
@@ -989,22 +799,22 @@ bool CDMRGateway::createMMDVM()
 	return true;
 }
 
-bool CDMRGateway::createDMRNetwork1()
+bool CDMRGateway::createDMRNetwork(const CDMRNetworkStruct& conf)
 {
-	std::string address  = m_conf.getDMRNetwork1Address();
-	unsigned int port    = m_conf.getDMRNetwork1Port();
-	unsigned int local   = m_conf.getDMRNetwork1Local();
-	unsigned int id      = m_conf.getDMRNetwork1Id();
-	std::string password = m_conf.getDMRNetwork1Password();
-	bool location        = m_conf.getDMRNetwork1Location();
-	bool debug           = m_conf.getDMRNetwork1Debug();
-	m_dmr1Name           = m_conf.getDMRNetwork1Name();
+	std::string address  = conf.m_address;
+	unsigned int port    = conf.m_port;
+	unsigned int local   = conf.m_local;
+	unsigned int id      = conf.m_id;
+	std::string password = conf.m_password;
+	bool location        = conf.m_location;
+	bool debug           = conf.m_debug;
+	std::string name     = conf.m_name;
 
 	if (id == 0U)
 		id = m_repeater->getId();
 
-	LogInfo("DMR Network 1 Parameters");
-	LogInfo("    Name: %s", m_dmr1Name.c_str());
+	LogInfo("DMR Network %u Parameters", conf.m_number);
+	LogInfo("    Name: %s", name.c_str());
 	LogInfo("    Id: %u", id);
 	LogInfo("    Address: %s", address.c_str());
 	LogInfo("    Port: %u", port);
@@ -1013,161 +823,50 @@ bool CDMRGateway::createDMRNetwork1()
 	else
 		LogInfo("    Local: random");
 	LogInfo("    Location Data: %s", location ? "yes" : "no");
+	if (conf.m_jitter > 0U)
+		LogInfo("    Jitter Buffer: %u ms", conf.m_jitter);
+	else
+		LogInfo("    Jitter Buffer: disabled");
 
-	m_dmrNetwork1 = new CDMRNetwork(address, port, local, id, password, m_dmr1Name, VERSION, debug);
+	CDMRNetwork* network = new CDMRNetwork(address, port, local, id, password, name, VERSION, m_budget, debug, m_resolver);
 
-	std::string options = m_conf.getDMRNetwork1Options();
+	network->setJitter(conf.m_jitter);
+
+	std::string options = conf.m_options;
 	if (options.empty())
 		options = m_repeater->getOptions();
 
 	if (!options.empty()) {
 		LogInfo("    Options: %s", options.c_str());
-		m_dmrNetwork1->setOptions(options);
+		network->setOptions(options);
 	}
 
 	unsigned char config[400U];
-	unsigned int len = getConfig(m_dmr1Name, config);
+	unsigned int len = getConfig(name, config);
 
 	if (!location)
 		::memcpy(config + 30U, "0.00000000.000000", 17U);
 
-	m_dmrNetwork1->setConfig(config, len);
+	network->setConfig(config, len);
 
-	bool ret = m_dmrNetwork1->open();
+	bool ret = network->open();
 	if (!ret) {
-		delete m_dmrNetwork1;
-		m_dmrNetwork1 = NULL;
+		delete network;
 		return false;
 	}
 
-	std::vector<CTGRewriteStruct> tgRewrites = m_conf.getDMRNetwork1TGRewrites();
-	for (std::vector<CTGRewriteStruct>::const_iterator it = tgRewrites.begin(); it != tgRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite RF: %u:TG%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG);
-		else
-			LogInfo("    Rewrite RF: %u:TG%u-TG%u -> %u:TG%u-TG%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_fromTG + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toTG, (*it).m_toTG + (*it).m_range - 1U);
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite Net: %u:TG%u -> %u:TG%u", (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG);
-		else
-			LogInfo("    Rewrite Net: %u:TG%u-TG%u -> %u:TG%u-TG%u", (*it).m_toSlot, (*it).m_toTG, (*it).m_toTG + (*it).m_range - 1U, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_fromTG + (*it).m_range - 1U);
-
-		CRewriteTG* rfRewrite  = new CRewriteTG(m_dmr1Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
-		CRewriteTG* netRewrite = new CRewriteTG(m_dmr1Name, (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_range);
-
-		m_dmr1RFRewrites.push_back(rfRewrite);
-		m_dmr1NetRewrites.push_back(netRewrite);
-	}
-
-	std::vector<CPCRewriteStruct> pcRewrites = m_conf.getDMRNetwork1PCRewrites();
-	for (std::vector<CPCRewriteStruct>::const_iterator it = pcRewrites.begin(); it != pcRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite RF: %u:%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId);
-		else
-			LogInfo("    Rewrite RF: %u:%u-%u -> %u:%u-%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toId, (*it).m_toId + (*it).m_range - 1U);
-
-		CRewritePC* rewrite = new CRewritePC(m_dmr1Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId, (*it).m_range);
-
-		m_dmr1RFRewrites.push_back(rewrite);
-	}
-
-	std::vector<CTypeRewriteStruct> typeRewrites = m_conf.getDMRNetwork1TypeRewrites();
-	for (std::vector<CTypeRewriteStruct>::const_iterator it = typeRewrites.begin(); it != typeRewrites.end(); ++it) {
-		LogInfo("    Rewrite RF: %u:TG%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
-
-		CRewriteType* rewrite = new CRewriteType(m_dmr1Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
-
-		m_dmr1RFRewrites.push_back(rewrite);
-	}
-
-	std::vector<CSrcRewriteStruct> srcRewrites = m_conf.getDMRNetwork1SrcRewrites();
-	for (std::vector<CSrcRewriteStruct>::const_iterator it = srcRewrites.begin(); it != srcRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite Net: %u:%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG);
-		else
-			LogInfo("    Rewrite Net: %u:%u-%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toTG);
-
-		CRewriteSrc* rewrite = new CRewriteSrc(m_dmr1Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
-
-		m_dmr1NetRewrites.push_back(rewrite);
-	}
-
-	std::vector<unsigned int> tgPassAll = m_conf.getDMRNetwork1PassAllTG();
-	for (std::vector<unsigned int>::const_iterator it = tgPassAll.begin(); it != tgPassAll.end(); ++it) {
-		LogInfo("    Pass All TG: %u", *it);
-
-		CPassAllTG* rfPassAllTG  = new CPassAllTG(m_dmr1Name, *it);
-		CPassAllTG* netPassAllTG = new CPassAllTG(m_dmr1Name, *it);
-
-		m_dmr1Passalls.push_back(rfPassAllTG);
-		m_dmr1NetRewrites.push_back(netPassAllTG);
-	}
-
-	std::vector<unsigned int> pcPassAll = m_conf.getDMRNetwork1PassAllPC();
-	for (std::vector<unsigned int>::const_iterator it = pcPassAll.begin(); it != pcPassAll.end(); ++it) {
-		LogInfo("    Pass All PC: %u", *it);
-
-		CPassAllPC* rfPassAllPC  = new CPassAllPC(m_dmr1Name, *it);
-		CPassAllPC* netPassAllPC = new CPassAllPC(m_dmr1Name, *it);
-
-		m_dmr1Passalls.push_back(rfPassAllPC);
-		m_dmr1NetRewrites.push_back(netPassAllPC);
-	}
-
-	return true;
-}
-
-bool CDMRGateway::createDMRNetwork2()
-{
-	std::string address  = m_conf.getDMRNetwork2Address();
-	unsigned int port    = m_conf.getDMRNetwork2Port();
-	unsigned int local   = m_conf.getDMRNetwork2Local();
-	unsigned int id      = m_conf.getDMRNetwork2Id();
-	std::string password = m_conf.getDMRNetwork2Password();
-	bool location        = m_conf.getDMRNetwork2Location();
-	bool debug           = m_conf.getDMRNetwork2Debug();
-	m_dmr2Name           = m_conf.getDMRNetwork2Name();
-
-	if (id == 0U)
-		id = m_repeater->getId();
-
-	LogInfo("DMR Network 2 Parameters");
-	LogInfo("    Name: %s", m_dmr2Name.c_str());
-	LogInfo("    Id: %u", id);
-	LogInfo("    Address: %s", address.c_str());
-	LogInfo("    Port: %u", port);
-	if (local > 0U)
-		LogInfo("    Local: %u", local);
-	else
-		LogInfo("    Local: random");
-	LogInfo("    Location Data: %s", location ? "yes" : "no");
+	if (m_threaded)
+		network->startThread(&m_poller);
 
-	m_dmrNetwork2 = new CDMRNetwork(address, port, local, id, password, m_dmr2Name, VERSION, debug);
+	CDMRGatewayNetwork* dmrNetwork = new CDMRGatewayNetwork;
+	dmrNetwork->m_number  = conf.m_number;
+	dmrNetwork->m_name    = name;
+	dmrNetwork->m_network = network;
+	dmrNetwork->m_srcId[1U] = dmrNetwork->m_srcId[2U] = dmrNetwork->m_dstId[1U] = dmrNetwork->m_dstId[2U] = 0U;
 
-	std::string options = m_conf.getDMRNetwork2Options();
-	if (options.empty())
-		options = m_repeater->getOptions();
+	m_dmrNetworks.push_back(dmrNetwork);
 
-	if (!options.empty()) {
-		LogInfo("    Options: %s", options.c_str());
-		m_dmrNetwork2->setOptions(options);
-	}
-
-	unsigned char config[400U];
-	unsigned int len = getConfig(m_dmr2Name, config);
-
-	if (!location)
-		::memcpy(config + 30U, "0.00000000.000000", 17U);
-
-	m_dmrNetwork2->setConfig(config, len);
-
-	bool ret = m_dmrNetwork2->open();
-	if (!ret) {
-		delete m_dmrNetwork2;
-		m_dmrNetwork2 = NULL;
-		return false;
-	}
-
-	std::vector<CTGRewriteStruct> tgRewrites = m_conf.getDMRNetwork2TGRewrites();
+	std::vector<CTGRewriteStruct> tgRewrites = conf.m_tgRewrites;
 	for (std::vector<CTGRewriteStruct>::const_iterator it = tgRewrites.begin(); it != tgRewrites.end(); ++it) {
 		if ((*it).m_range == 1)
 			LogInfo("    Rewrite RF: %u:TG%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG);
@@ -1178,196 +877,96 @@ bool CDMRGateway::createDMRNetwork2()
 		else
 			LogInfo("    Rewrite Net: %u:TG%u-TG%u -> %u:TG%u-TG%u", (*it).m_toSlot, (*it).m_toTG, (*it).m_toTG + (*it).m_range - 1U, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_fromTG + (*it).m_range - 1U);
 
-		CRewriteTG* rfRewrite  = new CRewriteTG(m_dmr2Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
-		CRewriteTG* netRewrite = new CRewriteTG(m_dmr2Name, (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_range);
+		CRewriteTG* rfRewrite  = new CRewriteTG(name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
+		CRewriteTG* netRewrite = new CRewriteTG(name, (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_range);
 
-		m_dmr2RFRewrites.push_back(rfRewrite);
-		m_dmr2NetRewrites.push_back(netRewrite);
+		dmrNetwork->m_rfRewrites.push_back(rfRewrite);
+		dmrNetwork->m_netRewrites.push_back(netRewrite);
 	}
 
-	std::vector<CPCRewriteStruct> pcRewrites = m_conf.getDMRNetwork2PCRewrites();
+	std::vector<CPCRewriteStruct> pcRewrites = conf.m_pcRewrites;
 	for (std::vector<CPCRewriteStruct>::const_iterator it = pcRewrites.begin(); it != pcRewrites.end(); ++it) {
 		if ((*it).m_range == 1)
 			LogInfo("    Rewrite RF: %u:%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId);
 		else
 			LogInfo("    Rewrite RF: %u:%u-%u -> %u:%u-%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toId, (*it).m_toId + (*it).m_range - 1U);
 
-		CRewritePC* rewrite = new CRewritePC(m_dmr2Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId, (*it).m_range);
+		CRewritePC* rewrite = new CRewritePC(name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId, (*it).m_range);
 
-		m_dmr2RFRewrites.push_back(rewrite);
+		dmrNetwork->m_rfRewrites.push_back(rewrite);
 	}
 
-	std::vector<CTypeRewriteStruct> typeRewrites = m_conf.getDMRNetwork2TypeRewrites();
+	std::vector<CTypeRewriteStruct> typeRewrites = conf.m_typeRewrites;
 	for (std::vector<CTypeRewriteStruct>::const_iterator it = typeRewrites.begin(); it != typeRewrites.end(); ++it) {
 		LogInfo("    Rewrite RF: %u:TG%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
 
-		CRewriteType* rewrite = new CRewriteType(m_dmr2Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
+		CRewriteType* rewrite = new CRewriteType(name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
 
-		m_dmr2RFRewrites.push_back(rewrite);
+		dmrNetwork->m_rfRewrites.push_back(rewrite);
 	}
 
-	std::vector<CSrcRewriteStruct> srcRewrites = m_conf.getDMRNetwork2SrcRewrites();
+	std::vector<CSrcRewriteStruct> srcRewrites = conf.m_srcRewrites;
 	for (std::vector<CSrcRewriteStruct>::const_iterator it = srcRewrites.begin(); it != srcRewrites.end(); ++it) {
 		if ((*it).m_range == 1)
 			LogInfo("    Rewrite Net: %u:%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG);
 		else
 			LogInfo("    Rewrite Net: %u:%u-%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toTG);
 
-		CRewriteSrc* rewrite = new CRewriteSrc(m_dmr2Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
+		CRewriteSrc* rewrite = new CRewriteSrc(name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
 
-		m_dmr2NetRewrites.push_back(rewrite);
+		dmrNetwork->m_netRewrites.push_back(rewrite);
 	}
 
-	std::vector<unsigned int> tgPassAll = m_conf.getDMRNetwork2PassAllTG();
+	std::vector<unsigned int> tgPassAll = conf.m_passAllTG;
 	for (std::vector<unsigned int>::const_iterator it = tgPassAll.begin(); it != tgPassAll.end(); ++it) {
 		LogInfo("    Pass All TG: %u", *it);
 
-		CPassAllTG* rfPassAllTG  = new CPassAllTG(m_dmr2Name, *it);
-		CPassAllTG* netPassAllTG = new CPassAllTG(m_dmr2Name, *it);
+		CPassAllTG* rfPassAllTG  = new CPassAllTG(name, *it);
+		CPassAllTG* netPassAllTG = new CPassAllTG(name, *it);
 
-		m_dmr2Passalls.push_back(rfPassAllTG);
-		m_dmr2NetRewrites.push_back(netPassAllTG);
+		dmrNetwork->m_passalls.push_back(rfPassAllTG);
+		dmrNetwork->m_netRewrites.push_back(netPassAllTG);
 	}
 
-	std::vector<unsigned int> pcPassAll = m_conf.getDMRNetwork2PassAllPC();
+	std::vector<unsigned int> pcPassAll = conf.m_passAllPC;
 	for (std::vector<unsigned int>::const_iterator it = pcPassAll.begin(); it != pcPassAll.end(); ++it) {
 		LogInfo("    Pass All PC: %u", *it);
 
-		CPassAllPC* rfPassAllPC  = new CPassAllPC(m_dmr2Name, *it);
-		CPassAllPC* netPassAllPC = new CPassAllPC(m_dmr2Name, *it);
+		CPassAllPC* rfPassAllPC  = new CPassAllPC(name, *it);
+		CPassAllPC* netPassAllPC = new CPassAllPC(name, *it);
 
-		m_dmr2Passalls.push_back(rfPassAllPC);
-		m_dmr2NetRewrites.push_back(netPassAllPC);
+		dmrNetwork->m_passalls.push_back(rfPassAllPC);
+		dmrNetwork->m_netRewrites.push_back(netPassAllPC);
 	}
 
 	return true;
 }
 
-bool CDMRGateway::createDMRNetwork3()
+void CDMRGateway::createRoutingTables()
 {
-	std::string address  = m_conf.getDMRNetwork3Address();
-	unsigned int port    = m_conf.getDMRNetwork3Port();
-	unsigned int local   = m_conf.getDMRNetwork3Local();
-	unsigned int id      = m_conf.getDMRNetwork3Id();
-	std::string password = m_conf.getDMRNetwork3Password();
-	bool location        = m_conf.getDMRNetwork3Location();
-	bool debug           = m_conf.getDMRNetwork3Debug();
-	m_dmr3Name           = m_conf.getDMRNetwork3Name();
-
-	if (id == 0U)
-		id = m_repeater->getId();
-
-	LogInfo("DMR Network 3 Parameters");
-	LogInfo("    Name: %s", m_dmr3Name.c_str());
-	LogInfo("    Id: %u", id);
-	LogInfo("    Address: %s", address.c_str());
-	LogInfo("    Port: %u", port);
-	if (local > 0U)
-		LogInfo("    Local: %u", local);
-	else
-		LogInfo("    Local: random");
-	LogInfo("    Location Data: %s", location ? "yes" : "no");
-
-	m_dmrNetwork3 = new CDMRNetwork(address, port, local, id, password, m_dmr3Name, VERSION, debug);
-
-	std::string options = m_conf.getDMRNetwork3Options();
-	if (options.empty())
-		options = m_repeater->getOptions();
-
-	if (!options.empty()) {
-		LogInfo("    Options: %s", options.c_str());
-		m_dmrNetwork3->setOptions(options);
+	// The RF rules are tried in the same order as the networks, followed by the pass all rules
+	for (unsigned int i = 0U; i < m_dmrNetworks.size(); i++) {
+		for (std::vector<CRewrite*>::const_iterator it = m_dmrNetworks[i]->m_rfRewrites.begin(); it != m_dmrNetworks[i]->m_rfRewrites.end(); ++it)
+			m_rfRoutes.add(*it, i + 1U);
 	}
-
-	unsigned char config[400U];
-	unsigned int len = getConfig(m_dmr3Name, config);
-
-	if (!location)
-		::memcpy(config + 30U, "0.00000000.000000", 17U);
-
-	m_dmrNetwork3->setConfig(config, len);
-
-	bool ret = m_dmrNetwork3->open();
-	if (!ret) {
-		delete m_dmrNetwork3;
-		m_dmrNetwork3 = NULL;
-		return false;
+	for (unsigned int i = 0U; i < m_dmrNetworks.size(); i++) {
+		for (std::vector<CRewrite*>::const_iterator it = m_dmrNetworks[i]->m_passalls.begin(); it != m_dmrNetworks[i]->m_passalls.end(); ++it)
+			m_rfRoutes.add(*it, i + 1U);
 	}
 
-	std::vector<CTGRewriteStruct> tgRewrites = m_conf.getDMRNetwork3TGRewrites();
-	for (std::vector<CTGRewriteStruct>::const_iterator it = tgRewrites.begin(); it != tgRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite RF: %u:TG%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG);
-		else
-			LogInfo("    Rewrite RF: %u:TG%u-TG%u -> %u:TG%u-TG%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_fromTG + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toTG, (*it).m_toTG + (*it).m_range - 1U);
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite Net: %u:TG%u -> %u:TG%u", (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG);
-		else
-			LogInfo("    Rewrite Net: %u:TG%u-TG%u -> %u:TG%u-TG%u", (*it).m_toSlot, (*it).m_toTG, (*it).m_toTG + (*it).m_range - 1U, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_fromTG + (*it).m_range - 1U);
-
-		CRewriteTG* rfRewrite = new CRewriteTG(m_dmr3Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
-		CRewriteTG* netRewrite = new CRewriteTG(m_dmr3Name, (*it).m_toSlot, (*it).m_toTG, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_range);
-
-		m_dmr3RFRewrites.push_back(rfRewrite);
-		m_dmr3NetRewrites.push_back(netRewrite);
-	}
-
-	std::vector<CPCRewriteStruct> pcRewrites = m_conf.getDMRNetwork3PCRewrites();
-	for (std::vector<CPCRewriteStruct>::const_iterator it = pcRewrites.begin(); it != pcRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite RF: %u:%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId);
-		else
-			LogInfo("    Rewrite RF: %u:%u-%u -> %u:%u-%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toId, (*it).m_toId + (*it).m_range - 1U);
-
-		CRewritePC* rewrite = new CRewritePC(m_dmr3Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toId, (*it).m_range);
-
-		m_dmr3RFRewrites.push_back(rewrite);
+	for (unsigned int i = 0U; i < m_dmrNetworks.size(); i++) {
+		for (std::vector<CRewrite*>::const_iterator it = m_dmrNetworks[i]->m_netRewrites.begin(); it != m_dmrNetworks[i]->m_netRewrites.end(); ++it)
+			m_dmrNetworks[i]->m_netRoutes.add(*it, i + 1U);
 	}
 
-	std::vector<CTypeRewriteStruct> typeRewrites = m_conf.getDMRNetwork3TypeRewrites();
-	for (std::vector<CTypeRewriteStruct>::const_iterator it = typeRewrites.begin(); it != typeRewrites.end(); ++it) {
-		LogInfo("    Rewrite RF: %u:TG%u -> %u:%u", (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
+	m_rfRoutes.compile();
+	for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+		(*it)->m_netRoutes.compile();
 
-		CRewriteType* rewrite = new CRewriteType(m_dmr3Name, (*it).m_fromSlot, (*it).m_fromTG, (*it).m_toSlot, (*it).m_toId);
-
-		m_dmr3RFRewrites.push_back(rewrite);
-	}
-
-	std::vector<CSrcRewriteStruct> srcRewrites = m_conf.getDMRNetwork3SrcRewrites();
-	for (std::vector<CSrcRewriteStruct>::const_iterator it = srcRewrites.begin(); it != srcRewrites.end(); ++it) {
-		if ((*it).m_range == 1)
-			LogInfo("    Rewrite Net: %u:%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG);
-		else
-			LogInfo("    Rewrite Net: %u:%u-%u -> %u:TG%u", (*it).m_fromSlot, (*it).m_fromId, (*it).m_fromId + (*it).m_range - 1U, (*it).m_toSlot, (*it).m_toTG);
-
-		CRewriteSrc* rewrite = new CRewriteSrc(m_dmr3Name, (*it).m_fromSlot, (*it).m_fromId, (*it).m_toSlot, (*it).m_toTG, (*it).m_range);
-
-		m_dmr3NetRewrites.push_back(rewrite);
-	}
-
-	std::vector<unsigned int> tgPassAll = m_conf.getDMRNetwork3PassAllTG();
-	for (std::vector<unsigned int>::const_iterator it = tgPassAll.begin(); it != tgPassAll.end(); ++it) {
-		LogInfo("    Pass All TG: %u", *it);
-
-		CPassAllTG* rfPassAllTG = new CPassAllTG(m_dmr3Name, *it);
-		CPassAllTG* netPassAllTG = new CPassAllTG(m_dmr3Name, *it);
-
-		m_dmr3Passalls.push_back(rfPassAllTG);
-		m_dmr3NetRewrites.push_back(netPassAllTG);
-	}
-
-	std::vector<unsigned int> pcPassAll = m_conf.getDMRNetwork3PassAllPC();
-	for (std::vector<unsigned int>::const_iterator it = pcPassAll.begin(); it != pcPassAll.end(); ++it) {
-		LogInfo("    Pass All PC: %u", *it);
-
-		CPassAllPC* rfPassAllPC = new CPassAllPC(m_dmr3Name, *it);
-		CPassAllPC* netPassAllPC = new CPassAllPC(m_dmr3Name, *it);
-
-		m_dmr3Passalls.push_back(rfPassAllPC);
-		m_dmr3NetRewrites.push_back(netPassAllPC);
-	}
-
-	return true;
+	LogInfo("Routing Tables");
+	LogInfo("    RF: %u rules in %u ranges", m_rfRoutes.getRules(), m_rfRoutes.getRanges());
+	for (std::vector<CDMRGatewayNetwork*>::const_iterator it = m_dmrNetworks.begin(); it != m_dmrNetworks.end(); ++it)
+		LogInfo("    %s: %u rules in %u ranges", (*it)->m_name.c_str(), (*it)->m_netRoutes.getRules(), (*it)->m_netRoutes.getRanges());
 }
 
 bool CDMRGateway::createXLXNetwork()
@@ -1455,7 +1054,7 @@ bool CDMRGateway::linkXLX(unsigned int number)
 	m_xlxConnected = false;
 	m_xlxRelink.stop();
 
-	m_xlxNetwork = new CDMRNetwork(reflector->m_address, m_xlxPort, m_xlxLocal, m_xlxId, m_xlxPassword, "XLX", VERSION, m_xlxDebug);
+	m_xlxNetwork = new CDMRNetwork(reflector->m_address, m_xlxPort, m_xlxLocal, m_xlxId, m_xlxPassword, "XLX", VERSION, m_budget, m_xlxDebug, m_resolver);
 
 	unsigned char config[400U];
 	unsigned int len = getConfig("XLX", config);
@@ -1469,6 +1068,9 @@ bool CDMRGateway::linkXLX(unsigned int number)
 		return false;
 	}
 
+	if (m_threaded)
+		m_xlxNetwork->startThread(&m_poller);
+
 	m_xlxNumber    = number;
     if (m_xlxModule) {
         m_xlxRoom  = ((int(m_xlxModule) - 64U) + 4000U);
@@ -23,12 +23,29 @@
 #include "MMDVMNetwork.h"
 #include "DMRNetwork.h"
 #include "Reflectors.h"
+#include "Resolver.h"
+#include "RoutingTable.h"
 #include "RewriteTG.h"
 #include "Rewrite.h"
+#include "Poller.h"
 #include "Timer.h"
 #include "Conf.h"
 
 #include <string>
+#include <vector>
+
+// One of the [DMR Network N] sections along with its rules and routing table
+struct CDMRGatewayNetwork {
+	unsigned int           m_number;
+	std::string            m_name;
+	CDMRNetwork*           m_network;
+	std::vector<CRewrite*> m_netRewrites;
+	std::vector<CRewrite*> m_rfRewrites;
+	std::vector<CRewrite*> m_passalls;
+	CRoutingTable          m_netRoutes;
+	unsigned int           m_srcId[3U];
+	unsigned int           m_dstId[3U];
+};
 
 class CDMRGateway
 {
@@ -43,12 +60,11 @@ private:
 	IRepeaterProtocol* m_repeater;
 	unsigned char*     m_config;
 	unsigned int       m_configLen;
-	CDMRNetwork*       m_dmrNetwork1;
-	std::string        m_dmr1Name;
-	CDMRNetwork*       m_dmrNetwork2;
-	std::string        m_dmr2Name;
-	CDMRNetwork*       m_dmrNetwork3;
-	std::string        m_dmr3Name;
+	unsigned int       m_budget;
+	bool               m_threaded;
+	CPoller            m_poller;
+	CResolver*         m_resolver;
+	std::vector<CDMRGatewayNetwork*> m_dmrNetworks;
 	CReflectors*       m_xlxReflectors;
 	CDMRNetwork*       m_xlxNetwork;
 	unsigned int       m_xlxId;
@@ -69,21 +85,12 @@ private:
     char               m_xlxModule;
 	CRewriteTG*        m_rptRewrite;
 	CRewriteTG*        m_xlxRewrite;
-	std::vector<CRewrite*> m_dmr1NetRewrites;
-	std::vector<CRewrite*> m_dmr1RFRewrites;
-	std::vector<CRewrite*> m_dmr2NetRewrites;
-	std::vector<CRewrite*> m_dmr2RFRewrites;
-	std::vector<CRewrite*> m_dmr3NetRewrites;
-	std::vector<CRewrite*> m_dmr3RFRewrites;
-	std::vector<CRewrite*> m_dmr1Passalls;
-	std::vector<CRewrite*> m_dmr2Passalls;
-	std::vector<CRewrite*> m_dmr3Passalls;
+	CRoutingTable      m_rfRoutes;
 
 	bool createMMDVM();
-	bool createDMRNetwork1();
-	bool createDMRNetwork2();
-	bool createDMRNetwork3();
+	bool createDMRNetwork(const CDMRNetworkStruct& conf);
 	bool createXLXNetwork();
+	void createRoutingTables();
 
 	bool linkXLX(unsigned int number);
 	void unlinkXLX();
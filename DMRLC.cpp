@@ -18,8 +18,6 @@
 
 #include "DMRLC.h"
 
-#include "Utils.h"
-
 #include <cstdio>
 #include <cassert>
 
@@ -58,44 +56,6 @@ m_dstId(0U)
 	m_srcId = bytes[6U] << 16 | bytes[7U] << 8 | bytes[8U];
 }
 
-CDMRLC::CDMRLC(const bool* bits) :
-m_PF(false),
-m_R(false),
-m_FLCO(FLCO_GROUP),
-m_FID(0U),
-m_options(0U),
-m_srcId(0U),
-m_dstId(0U)
-{
-	assert(bits != NULL);
-
-	m_PF = bits[0U];
-	m_R  = bits[1U];
-
-	unsigned char temp1, temp2, temp3;
-	CUtils::bitsToByteBE(bits + 0U, temp1);
-	m_FLCO = FLCO(temp1 & 0x3FU);
-
-	CUtils::bitsToByteBE(bits + 8U, temp2);
-	m_FID = temp2;
-
-	CUtils::bitsToByteBE(bits + 16U, temp3);
-	m_options = temp3;
-
-	unsigned char d1, d2, d3;
-	CUtils::bitsToByteBE(bits + 24U, d1);
-	CUtils::bitsToByteBE(bits + 32U, d2);
-	CUtils::bitsToByteBE(bits + 40U, d3);
-
-	unsigned char s1, s2, s3;
-	CUtils::bitsToByteBE(bits + 48U, s1);
-	CUtils::bitsToByteBE(bits + 56U, s2);
-	CUtils::bitsToByteBE(bits + 64U, s3);
-
-	m_srcId = s1 << 16 | s2 << 8 | s3;
-	m_dstId = d1 << 16 | d2 << 8 | d3;
-}
-
 CDMRLC::CDMRLC() :
 m_PF(false),
 m_R(false),
@@ -136,24 +96,6 @@ void CDMRLC::getData(unsigned char* bytes) const
 	bytes[8U] = m_srcId >> 0;
 }
 
-void CDMRLC::getData(bool* bits) const
-{
-	assert(bits != NULL);
-
-	unsigned char bytes[9U];
-	getData(bytes);
-
-	CUtils::byteToBitsBE(bytes[0U], bits + 0U);
-	CUtils::byteToBitsBE(bytes[1U], bits + 8U);
-	CUtils::byteToBitsBE(bytes[2U], bits + 16U);
-	CUtils::byteToBitsBE(bytes[3U], bits + 24U);
-	CUtils::byteToBitsBE(bytes[4U], bits + 32U);
-	CUtils::byteToBitsBE(bytes[5U], bits + 40U);
-	CUtils::byteToBitsBE(bytes[6U], bits + 48U);
-	CUtils::byteToBitsBE(bytes[7U], bits + 56U);
-	CUtils::byteToBitsBE(bytes[8U], bits + 64U);
-}
-
 bool CDMRLC::getPF() const
 {
 	return m_PF;
@@ -26,12 +26,10 @@ class CDMRLC
 public:
 	CDMRLC(FLCO flco, unsigned int srcId, unsigned int dstId);
 	CDMRLC(const unsigned char* bytes);
-	CDMRLC(const bool* bits);
 	CDMRLC();
 	~CDMRLC();
 
 	void getData(unsigned char* bytes) const;
-	void getData(bool* bits) const;
 
 	bool getPF() const;
 	void setPF(bool pf);
@@ -24,44 +24,59 @@
 #include "Log.h"
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
-const unsigned int BUFFER_LENGTH = 500U;
+const unsigned int RX_QUEUE_LENGTH = 16U;
+const unsigned int TX_QUEUE_LENGTH = 20U;
 
-const unsigned int HOMEBREW_DATA_PACKET_LENGTH = 55U;
+const unsigned int THREAD_WAIT_TIME = 1000U;
 
 
-CDMRNetwork::CDMRNetwork(const std::string& address, unsigned int port, unsigned int local, unsigned int id, const std::string& password, const std::string& name, const char* version, bool debug) :
+CDMRNetwork::CDMRNetwork(const std::string& address, unsigned int port, unsigned int local, unsigned int id, const std::string& password, const std::string& name, const char* version, unsigned int budget, bool debug, CResolver* resolver) :
+m_host(address),
+m_resolver(resolver),
 m_address(),
 m_port(port),
 m_id(NULL),
 m_password(password),
 m_name(name),
 m_version(version),
+m_budget(budget),
 m_debug(debug),
 m_socket(local),
 m_status(WAITING_CONNECT),
 m_retryTimer(1000U, 10U),
 m_timeoutTimer(1000U, 60U),
-m_buffer(NULL),
 m_salt(NULL),
-m_rxData(1000U, "DMR Network"),
+m_rxBatch(NULL),
+m_txQueue(NULL),
+m_txCount(0U),
+m_rxData(RX_QUEUE_LENGTH + budget, FQO_DROP_OLDEST, m_name.c_str()),
+m_jitter(0U),
+m_jitterBuffers(),
 m_options(),
 m_configData(NULL),
 m_configLen(0U),
-m_beacon(false)
+m_beacon(false),
+m_mutex(),
+m_threaded(false),
+m_stop(false),
+m_threadPoller(),
+m_poller(NULL)
 {
 	assert(!address.empty());
 	assert(port > 0U);
 	assert(id > 1000U);
 	assert(!password.empty());
 	assert(version != NULL);
+	assert(budget > 0U);
+	assert(resolver != NULL);
 
-	m_address = CUDPSocket::lookup(address);
-
-	m_buffer   = new unsigned char[BUFFER_LENGTH];
 	m_salt     = new unsigned char[sizeof(uint32_t)];
 	m_id       = new uint8_t[4U];
+	m_rxBatch  = new CUDPDatagram[budget];
+	m_txQueue  = new CUDPDatagram[TX_QUEUE_LENGTH];
 
 	m_id[0U] = id >> 24;
 	m_id[1U] = id >> 16;
@@ -74,9 +89,13 @@ m_beacon(false)
 
 CDMRNetwork::~CDMRNetwork()
 {
-	delete[] m_buffer;
 	delete[] m_salt;
 	delete[] m_id;
+	delete[] m_rxBatch;
+	delete[] m_txQueue;
+
+	delete m_jitterBuffers[1U];
+	delete m_jitterBuffers[2U];
 }
 
 void CDMRNetwork::setOptions(const std::string& options)
@@ -84,6 +103,17 @@ void CDMRNetwork::setOptions(const std::string& options)
 	m_options = options;
 }
 
+void CDMRNetwork::setJitter(unsigned int ms)
+{
+	if (ms == 0U)
+		return;
+
+	m_jitter = ms;
+
+	m_jitterBuffers[1U] = new CJitterBuffer(m_name, 1U, ms);
+	m_jitterBuffers[2U] = new CJitterBuffer(m_name, 2U, ms);
+}
+
 void CDMRNetwork::setConfig(const unsigned char* data, unsigned int len)
 {
 	m_configData = new unsigned char[len];
@@ -94,142 +124,152 @@ void CDMRNetwork::setConfig(const unsigned char* data, unsigned int len)
 
 bool CDMRNetwork::open()
 {
-	LogMessage("%s, Opening DMR Network", m_name.c_str());
+	std::lock_guard<std::mutex> lock(m_mutex);
 
-	m_status = WAITING_CONNECT;
-	m_timeoutTimer.stop();
-	m_retryTimer.start();
+	// Get the lookup going, it'll be done by the time the first login is due
+	bool changed;
+	resolve(changed);
+
+	connect();
 
 	return true;
 }
 
-bool CDMRNetwork::read(CDMRData& data)
+bool CDMRNetwork::startThread(CPoller* poller)
 {
-	if (m_status != RUNNING)
-		return false;
+	assert(poller != NULL);
 
-	if (m_rxData.isEmpty())
+	bool ret = m_threadPoller.open();
+	if (!ret)
 		return false;
 
-	unsigned char length = 0U;
+	m_poller   = poller;
+	m_stop     = false;
+	m_threaded = true;
 
-	m_rxData.getData(&length, 1U);
-	m_rxData.getData(m_buffer, length);
-
-	// Is this a data packet?
-	if (::memcmp(m_buffer, "DMRD", 4U) != 0)
+	ret = run();
+	if (!ret) {
+		LogError("%s, Unable to start the network thread", m_name.c_str());
+		m_threaded = false;
+		m_threadPoller.close();
 		return false;
+	}
 
-	unsigned char seqNo = m_buffer[4U];
+	return true;
+}
 
-	unsigned int srcId = (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
+void CDMRNetwork::entry()
+{
+	LogMessage("%s, Started the network thread", m_name.c_str());
 
-	unsigned int dstId = (m_buffer[8U] << 16) | (m_buffer[9U] << 8) | (m_buffer[10U] << 0);
+	CStopWatch stopWatch;
+	stopWatch.start();
 
-	unsigned int slotNo = (m_buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+	unsigned int lastTime = 0U;
 
-	FLCO flco = (m_buffer[15U] & 0x40U) == 0x40U ? FLCO_USER_USER : FLCO_GROUP;
+	while (!m_stop) {
+		unsigned int elapsed = stopWatch.elapsed();
+		unsigned int ms = elapsed - lastTime;
+		lastTime = elapsed;
 
-	unsigned int streamId;
-	::memcpy(&streamId, m_buffer + 16U, 4U);
+		bool received;
+		unsigned int timeout;
+		int fd;
 
-	unsigned char ber  = m_buffer[53U];
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
 
-	unsigned char rssi = m_buffer[54U];
+			received = process(ms);
+			send();
 
-	data.setSeqNo(seqNo);
-	data.setSlotNo(slotNo);
-	data.setSrcId(srcId);
-	data.setDstId(dstId);
-	data.setFLCO(flco);
-	data.setStreamId(streamId);
-	data.setBER(ber);
-	data.setRSSI(rssi);
+			timeout = deadline(THREAD_WAIT_TIME);
+			fd      = m_socket.getFd();
+		}
 
-	bool dataSync = (m_buffer[15U] & 0x20U) == 0x20U;
-	bool voiceSync = (m_buffer[15U] & 0x10U) == 0x10U;
+		if (received)
+			m_poller->wakeup();
 
-	if (dataSync) {
-		unsigned char dataType = m_buffer[15U] & 0x0FU;
-		data.setData(m_buffer + 20U);
-		data.setDataType(dataType);
-		data.setN(0U);
-	} else if (voiceSync) {
-		data.setData(m_buffer + 20U);
-		data.setDataType(DT_VOICE_SYNC);
-		data.setN(0U);
-	} else {
-		unsigned char n = m_buffer[15U] & 0x0FU;
-		data.setData(m_buffer + 20U);
-		data.setDataType(DT_VOICE);
-		data.setN(n);
+		m_threadPoller.wait(&fd, 1U, timeout);
 	}
 
-	return true;
+	LogMessage("%s, Stopped the network thread", m_name.c_str());
 }
 
-bool CDMRNetwork::write(const CDMRData& data)
+bool CDMRNetwork::resolve(bool& changed)
 {
-	if (m_status != RUNNING)
+	changed = false;
+
+	CUDPAddress address;
+	bool ret = m_resolver->lookup(m_host, address);
+	if (!ret)
 		return false;
 
-	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
-	::memset(buffer, 0x00U, HOMEBREW_DATA_PACKET_LENGTH);
+	address.setPort(m_port);
 
-	buffer[0U]  = 'D';
-	buffer[1U]  = 'M';
-	buffer[2U]  = 'R';
-	buffer[3U]  = 'D';
+	changed = address != m_address;
+	m_address = address;
 
-	unsigned int srcId = data.getSrcId();
-	buffer[5U]  = srcId >> 16;
-	buffer[6U]  = srcId >> 8;
-	buffer[7U]  = srcId >> 0;
+	return true;
+}
 
-	unsigned int dstId = data.getDstId();
-	buffer[8U]  = dstId >> 16;
-	buffer[9U]  = dstId >> 8;
-	buffer[10U] = dstId >> 0;
+void CDMRNetwork::connect()
+{
+	LogMessage("%s, Opening DMR Network", m_name.c_str());
 
-	::memcpy(buffer + 11U, m_id, 4U);
+	m_status = WAITING_CONNECT;
+	m_timeoutTimer.stop();
+	m_retryTimer.start();
+}
+
+bool CDMRNetwork::read(CDMRData& data)
+{
+	if (m_status != RUNNING)
+		return false;
 
-	unsigned int slotNo = data.getSlotNo();
+	CDMRFrame frame;
 
-	buffer[15U] = slotNo == 1U ? 0x00U : 0x80U;
+	if (m_jitter == 0U) {
+		if (!m_rxData.getData(frame))
+			return false;
 
-	FLCO flco = data.getFLCO();
-	buffer[15U] |= flco == FLCO_GROUP ? 0x00U : 0x40U;
+		return data.setFrame(frame);
+	}
 
-	unsigned char dataType = data.getDataType();
-	if (dataType == DT_VOICE_SYNC) {
-		buffer[15U] |= 0x10U;
-	} else if (dataType == DT_VOICE) {
-		buffer[15U] |= data.getN();
-	} else {
-		buffer[15U] |= (0x20U | dataType);
+	// Everything that has arrived goes into the jitter buffers first
+	while (m_rxData.getData(frame)) {
+		CDMRData received;
+		if (received.setFrame(frame))
+			m_jitterBuffers[received.getSlotNo()]->addData(received);
 	}
 
-	buffer[4U] = data.getSeqNo();
+	if (m_jitterBuffers[1U]->getData(data))
+		return true;
 
-	unsigned int streamId = data.getStreamId();
-	::memcpy(buffer + 16U, &streamId, 4U);
+	return m_jitterBuffers[2U]->getData(data);
+}
 
-	data.getData(buffer + 20U);
+bool CDMRNetwork::write(const CDMRData& data)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
 
-	buffer[53U] = data.getBER();
+	if (m_status != RUNNING)
+		return false;
 
-	buffer[54U] = data.getRSSI();
+	CDMRFrame frame;
+	data.getFrame(frame, m_id);
 
 	if (m_debug)
-		CUtils::dump(1U, "Network Transmitted", buffer, HOMEBREW_DATA_PACKET_LENGTH);
+		CUtils::dump(1U, "Network Transmitted", (unsigned char*)&frame, sizeof(CDMRFrame));
 
-	write(buffer, HOMEBREW_DATA_PACKET_LENGTH);
+	write((unsigned char*)&frame, sizeof(CDMRFrame));
 
 	return true;
 }
 
 bool CDMRNetwork::writeRadioPosition(const unsigned char* data, unsigned int length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_status != RUNNING)
 		return false;
 
@@ -246,6 +286,8 @@ bool CDMRNetwork::writeRadioPosition(const unsigned char* data, unsigned int len
 
 bool CDMRNetwork::writeTalkerAlias(const unsigned char* data, unsigned int length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_status != RUNNING)
 		return false;
 
@@ -262,6 +304,8 @@ bool CDMRNetwork::writeTalkerAlias(const unsigned char* data, unsigned int lengt
 
 bool CDMRNetwork::writeHomePosition(const unsigned char* data, unsigned int length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_status != RUNNING)
 		return false;
 
@@ -276,12 +320,63 @@ bool CDMRNetwork::writeHomePosition(const unsigned char* data, unsigned int leng
 	return write(buffer, length);
 }
 
+int CDMRNetwork::getFd() const
+{
+	// The network thread does its own waiting
+	if (m_threaded)
+		return -1;
+
+	return m_socket.getFd();
+}
+
+unsigned int CDMRNetwork::getDeadline(unsigned int ms)
+{
+	// The jitter buffers belong to the reading thread
+	if (m_jitter > 0U) {
+		ms = m_jitterBuffers[1U]->getDeadline(ms);
+		ms = m_jitterBuffers[2U]->getDeadline(ms);
+	}
+
+	if (m_threaded)
+		return ms;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return deadline(ms);
+}
+
+unsigned int CDMRNetwork::deadline(unsigned int ms)
+{
+	ms = m_retryTimer.getDeadline(ms);
+
+	if (m_status == WAITING_CONNECT)
+		return ms;
+
+	return m_timeoutTimer.getDeadline(ms);
+}
+
 bool CDMRNetwork::isConnected() const
 {
 	return m_status == RUNNING;
 }
 
 void CDMRNetwork::close()
+{
+	if (m_threaded) {
+		m_stop = true;
+		m_threadPoller.wakeup();
+		wait();
+
+		m_threadPoller.close();
+		m_threaded = false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	disconnect();
+}
+
+void CDMRNetwork::disconnect()
 {
 	LogMessage("%s, Closing DMR Network", m_name.c_str());
 
@@ -292,6 +387,8 @@ void CDMRNetwork::close()
 		write(buffer, 9U);
 	}
 
+	send();
+
 	m_socket.close();
 
 	m_retryTimer.stop();
@@ -300,14 +397,33 @@ void CDMRNetwork::close()
 
 void CDMRNetwork::clock(unsigned int ms)
 {
+	if (m_threaded)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	process(ms);
+}
+
+bool CDMRNetwork::process(unsigned int ms)
+{
+	bool received = false;
+
 	if (m_status == WAITING_CONNECT) {
 		m_retryTimer.clock(ms);
 		if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
-			bool ret = m_socket.open();
+			bool changed;
+			if (!resolve(changed)) {
+				LogDebug("%s, Waiting for the address of the master", m_name.c_str());
+				m_retryTimer.start();
+				return false;
+			}
+
+			bool ret = m_socket.open(m_address.getFamily());
 			if (ret) {
 				ret = writeLogin();
 				if (!ret)
-					return;
+					return false;
 
 				m_status = WAITING_LOGIN;
 				m_timeoutTimer.start();
@@ -316,100 +432,112 @@ void CDMRNetwork::clock(unsigned int ms)
 			m_retryTimer.start();
 		}
 
-		return;
+		return false;
 	}
 
-	in_addr address;
-	unsigned int port;
-	int length = m_socket.read(m_buffer, BUFFER_LENGTH, address, port);
-	if (length < 0) {
+	// Read everything that is waiting, up to the budget for this pass
+	int count = m_socket.read(m_rxBatch, m_budget);
+	if (count < 0) {
 		LogError("%s, Socket has failed, retrying connection to the master", m_name.c_str());
-		close();
-		open();
-		return;
+		disconnect();
+		connect();
+		return false;
 	}
 
-	// if (m_debug && length > 0)
-	//	CUtils::dump(1U, "Network Received", m_buffer, length);
+	for (int i = 0; m_status != WAITING_CONNECT && i < count; i++) {
+		const unsigned char* buffer = m_rxBatch[i].m_data;
+		unsigned int length = m_rxBatch[i].m_length;
 
-	if (length > 0 && m_address.s_addr == address.s_addr && m_port == port) {
-		if (::memcmp(m_buffer, "DMRD", 4U) == 0) {
-			if (m_debug)
-				CUtils::dump(1U, "Network Received", m_buffer, length);
+		// if (m_debug && length > 0)
+		//	CUtils::dump(1U, "Network Received", buffer, length);
 
-			unsigned char len = length;
-			m_rxData.addData(&len, 1U);
-			m_rxData.addData(m_buffer, len);
-		} else if (::memcmp(m_buffer, "MSTNAK",  6U) == 0) {
-			if (m_status == RUNNING) {
-				LogWarning("%s, Login to the master has failed, retrying login ...", m_name.c_str());
-				m_status = WAITING_LOGIN;
-				m_timeoutTimer.start();
-				m_retryTimer.start();
-			} else {
-				/* Once the modem death spiral has been prevented in Modem.cpp
-				   the Network sometimes times out and reaches here.
-				   We want it to reconnect so... */
-				LogError("%s, Login to the master has failed, retrying network ...", m_name.c_str());
-				close();
-				open();
-				return;
-			}
-		} else if (::memcmp(m_buffer, "RPTACK",  6U) == 0) {
-			switch (m_status) {
-				case WAITING_LOGIN:
-					LogDebug("%s, Sending authorisation", m_name.c_str());
-					::memcpy(m_salt, m_buffer + 6U, sizeof(uint32_t));
-					writeAuthorisation();
-					m_status = WAITING_AUTHORISATION;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_AUTHORISATION:
-					LogDebug("%s, Sending configuration", m_name.c_str());
-					writeConfig();
-					m_status = WAITING_CONFIG;
+		if (m_address == m_rxBatch[i].m_address) {
+			if (::memcmp(buffer, "DMRD", 4U) == 0) {
+				if (m_debug)
+					CUtils::dump(1U, "Network Received", buffer, length);
+
+				m_rxData.addData(buffer, length);
+				received = true;
+			} else if (::memcmp(buffer, "MSTNAK",  6U) == 0) {
+				if (m_status == RUNNING) {
+					LogWarning("%s, Login to the master has failed, retrying login ...", m_name.c_str());
+					m_status = WAITING_LOGIN;
 					m_timeoutTimer.start();
 					m_retryTimer.start();
-					break;
-				case WAITING_CONFIG:
-					if (m_options.empty()) {
+				} else {
+					/* Once the modem death spiral has been prevented in Modem.cpp
+					   the Network sometimes times out and reaches here.
+					   We want it to reconnect so... */
+					LogError("%s, Login to the master has failed, retrying network ...", m_name.c_str());
+					disconnect();
+					connect();
+					return received;
+				}
+			} else if (::memcmp(buffer, "RPTACK",  6U) == 0) {
+				switch (m_status) {
+					case WAITING_LOGIN:
+						LogDebug("%s, Sending authorisation", m_name.c_str());
+						::memcpy(m_salt, buffer + 6U, sizeof(uint32_t));
+						writeAuthorisation();
+						m_status = WAITING_AUTHORISATION;
+						m_timeoutTimer.start();
+						m_retryTimer.start();
+						break;
+					case WAITING_AUTHORISATION:
+						LogDebug("%s, Sending configuration", m_name.c_str());
+						writeConfig();
+						m_status = WAITING_CONFIG;
+						m_timeoutTimer.start();
+						m_retryTimer.start();
+						break;
+					case WAITING_CONFIG:
+						if (m_options.empty()) {
+							LogMessage("%s, Logged into the master successfully", m_name.c_str());
+							m_status = RUNNING;
+						} else {
+							LogDebug("%s, Sending options", m_name.c_str());
+							writeOptions();
+							m_status = WAITING_OPTIONS;
+						}
+						m_timeoutTimer.start();
+						m_retryTimer.start();
+						break;
+					case WAITING_OPTIONS:
 						LogMessage("%s, Logged into the master successfully", m_name.c_str());
 						m_status = RUNNING;
-					} else {
-						LogDebug("%s, Sending options", m_name.c_str());
-						writeOptions();
-						m_status = WAITING_OPTIONS;
-					}
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_OPTIONS:
-					LogMessage("%s, Logged into the master successfully", m_name.c_str());
-					m_status = RUNNING;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				default:
-					break;
+						m_timeoutTimer.start();
+						m_retryTimer.start();
+						break;
+					default:
+						break;
+				}
+			} else if (::memcmp(buffer, "MSTCL",   5U) == 0) {
+				LogError("%s, Master is closing down", m_name.c_str());
+				disconnect();
+				connect();
+			} else if (::memcmp(buffer, "MSTPONG", 7U) == 0) {
+				m_timeoutTimer.start();
+			} else if (::memcmp(buffer, "RPTSBKN", 7U) == 0) {
+				m_beacon = true;
+			} else {
+				char text[100U];
+				::sprintf(text, "%s, Unknown packet from the master", m_name.c_str());
+				CUtils::dump(text, buffer, length);
 			}
-		} else if (::memcmp(m_buffer, "MSTCL",   5U) == 0) {
-			LogError("%s, Master is closing down", m_name.c_str());
-			close();
-			open();
-		} else if (::memcmp(m_buffer, "MSTPONG", 7U) == 0) {
-			m_timeoutTimer.start();
-		} else if (::memcmp(m_buffer, "RPTSBKN", 7U) == 0) {
-			m_beacon = true;
-		} else {
-			char buffer[100U];
-			::sprintf(buffer, "%s, Unknown packet from the master", m_name.c_str());
-			CUtils::dump(buffer, m_buffer, length);
 		}
 	}
 
 	m_retryTimer.clock(ms);
 	if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
+		// Follow a master on dynamic DNS when its address changes
+		bool changed;
+		if (m_status == RUNNING && resolve(changed) && changed) {
+			LogMessage("%s, The master has moved, reconnecting", m_name.c_str());
+			disconnect();
+			connect();
+			return received;
+		}
+
 		switch (m_status) {
 			case WAITING_LOGIN:
 				writeLogin();
@@ -436,9 +564,11 @@ void CDMRNetwork::clock(unsigned int ms)
 	m_timeoutTimer.clock(ms);
 	if (m_timeoutTimer.isRunning() && m_timeoutTimer.hasExpired()) {
 		LogError("%s, Connection to the master has timed out, retrying connection", m_name.c_str());
-		close();
-		open();
+		disconnect();
+		connect();
 	}
+
+	return received;
 }
 
 bool CDMRNetwork::writeLogin()
@@ -453,21 +583,13 @@ bool CDMRNetwork::writeLogin()
 
 bool CDMRNetwork::writeAuthorisation()
 {
-	size_t size = m_password.size();
-
-	unsigned char* in = new unsigned char[size + sizeof(uint32_t)];
-	::memcpy(in, m_salt, sizeof(uint32_t));
-	for (size_t i = 0U; i < size; i++)
-		in[i + sizeof(uint32_t)] = m_password.at(i);
-
 	unsigned char out[40U];
 	::memcpy(out + 0U, "RPTK", 4U);
 	::memcpy(out + 4U, m_id, 4U);
 
+	// The digest is of the salt followed by the password
 	CSHA256 sha256;
-	sha256.buffer(in, (unsigned int)(size + sizeof(uint32_t)), out + 8U);
-
-	delete[] in;
+	sha256.buffer(m_salt, sizeof(uint32_t), (const unsigned char*)m_password.c_str(), (unsigned int)m_password.size(), out + 8U);
 
 	return write(out, 40U);
 }
@@ -512,6 +634,8 @@ bool CDMRNetwork::writePing()
 
 bool CDMRNetwork::wantsBeacon()
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	bool beacon = m_beacon;
 
 	m_beacon = false;
@@ -522,18 +646,41 @@ bool CDMRNetwork::wantsBeacon()
 bool CDMRNetwork::write(const unsigned char* data, unsigned int length)
 {
 	assert(data != NULL);
-	assert(length > 0U);
+	assert(length > 0U && length <= UDP_DATAGRAM_LENGTH);
 
 	// if (m_debug)
 	//	CUtils::dump(1U, "Network Transmitted", data, length);
 
-	bool ret = m_socket.write(data, length, m_address, m_port);
+	if (m_txCount == TX_QUEUE_LENGTH)
+		send();
+
+	CUDPDatagram& datagram = m_txQueue[m_txCount++];
+	::memcpy(datagram.m_data, data, length);
+	datagram.m_length  = length;
+	datagram.m_address = m_address;
+
+	return true;
+}
+
+void CDMRNetwork::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	send();
+}
+
+void CDMRNetwork::send()
+{
+	if (m_txCount == 0U)
+		return;
+
+	unsigned int count = m_txCount;
+	m_txCount = 0U;
+
+	bool ret = m_socket.write(m_txQueue, count);
 	if (!ret) {
 		LogError("%s, Socket has failed when writing data to the master, retrying connection", m_name.c_str());
 		m_socket.close();
-		open();
-		return false;
+		connect();
 	}
-
-	return true;
 }
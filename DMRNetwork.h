@@ -21,24 +21,39 @@
 
 #include "UDPSocket.h"
 #include "Timer.h"
-#include "RingBuffer.h"
+#include "FrameQueue.h"
+#include "JitterBuffer.h"
 #include "DMRData.h"
+#include "Resolver.h"
+#include "Poller.h"
+#include "Thread.h"
 
 #include <string>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
 
-class CDMRNetwork
+// When started with startThread() the network is read and clocked on its own
+// thread, and received frames are handed over through the frame queue. Only
+// one other thread may call read(), everything else is serialised by a mutex.
+class CDMRNetwork : public CThread
 {
 public:
-	CDMRNetwork(const std::string& address, unsigned int port, unsigned int local, unsigned int id, const std::string& password, const std::string& name, const char* version, bool debug);
-	~CDMRNetwork();
+	CDMRNetwork(const std::string& address, unsigned int port, unsigned int local, unsigned int id, const std::string& password, const std::string& name, const char* version, unsigned int budget, bool debug, CResolver* resolver);
+	virtual ~CDMRNetwork();
 
 	void setOptions(const std::string& options);
 
+	// Received frames are held back by this many ms and put back in order, 0 turns it off
+	void setJitter(unsigned int ms);
+
 	void setConfig(const unsigned char* config, unsigned int len);
 
 	bool open();
 
+	// Wakes up the given poller whenever new frames have been queued
+	bool startThread(CPoller* poller);
+
 	bool read(CDMRData& data);
 
 	bool write(const CDMRData& data);
@@ -53,17 +68,29 @@ public:
 
 	void clock(unsigned int ms);
 
+	// Sends everything written since the last call in one batch
+	void flush();
+
+	int  getFd() const;
+
+	unsigned int getDeadline(unsigned int ms);
+
 	bool isConnected() const;
 
 	void close();
 
+	virtual void entry();
+
 private: 
-	in_addr      m_address;
+	std::string  m_host;
+	CResolver*   m_resolver;
+	CUDPAddress  m_address;
 	unsigned int m_port;
 	uint8_t*     m_id;
 	std::string  m_password;
 	std::string  m_name;
 	const char*  m_version;
+	unsigned int m_budget;
 	bool         m_debug;
 	CUDPSocket   m_socket;
 
@@ -76,13 +103,18 @@ private:
 		RUNNING
 	};
 
-	STATUS         m_status;
+	std::atomic<STATUS> m_status;
 	CTimer         m_retryTimer;
 	CTimer         m_timeoutTimer;
-	unsigned char* m_buffer;
 	unsigned char* m_salt;
+	CUDPDatagram*  m_rxBatch;
+	CUDPDatagram*  m_txQueue;
+	unsigned int   m_txCount;
+
+	CFrameQueue    m_rxData;
 
-	CRingBuffer<unsigned char> m_rxData;
+	unsigned int   m_jitter;
+	CJitterBuffer* m_jitterBuffers[3U];
 
 	std::string    m_options;
 
@@ -91,6 +123,12 @@ private:
 
 	bool           m_beacon;
 
+	std::mutex        m_mutex;
+	bool              m_threaded;
+	std::atomic<bool> m_stop;
+	CPoller           m_threadPoller;
+	CPoller*          m_poller;
+
 	bool writeLogin();
 	bool writeAuthorisation();
 	bool writeOptions();
@@ -98,6 +136,13 @@ private:
 	bool writePing();
 
 	bool write(const unsigned char* data, unsigned int length);
+
+	bool resolve(bool& changed);
+	void connect();
+	bool process(unsigned int ms);
+	void send();
+	unsigned int deadline(unsigned int ms);
+	void disconnect();
 };
 
 #endif
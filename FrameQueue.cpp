@@ -0,0 +1,136 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "FrameQueue.h"
+#include "Log.h"
+
+#include <cstring>
+#include <cassert>
+
+CFrameQueue::CFrameQueue(unsigned int length, FRAMEQUEUE_OVERFLOW overflow, const char* name) :
+m_length(1U),
+m_mask(0U),
+m_overflow(overflow),
+m_name(name),
+m_frames(NULL),
+m_overflowing(false),
+m_dropped(0U),
+m_pad1(),
+m_head(0U),
+m_pad2(),
+m_tail(0U),
+m_pad3()
+{
+	assert(length > 0U);
+	assert(name != NULL);
+
+	while (m_length < length)
+		m_length <<= 1;
+
+	m_mask = m_length - 1U;
+
+	m_frames = new CDMRFrame[m_length];
+}
+
+CFrameQueue::~CFrameQueue()
+{
+	delete[] m_frames;
+}
+
+bool CFrameQueue::addData(const unsigned char* data, unsigned int length)
+{
+	assert(data != NULL);
+
+	unsigned int tail = m_tail.load(std::memory_order_relaxed);
+	unsigned int head = m_head.load(std::memory_order_acquire);
+
+	if ((tail - head) >= m_length) {
+		if (m_overflow == FQO_DROP_NEWEST) {
+			m_dropped.fetch_add(1U, std::memory_order_relaxed);
+			if (!m_overflowing)
+				LogWarning("%s queue overflow, dropping new frames, %u dropped so far", m_name, m_dropped.load(std::memory_order_relaxed));
+			m_overflowing = true;
+			return false;
+		}
+
+		// Move the consumer on past the oldest frame, if it has not just taken
+		// it anyway. Either way there is now room for the new frame.
+		if (m_head.compare_exchange_strong(head, head + 1U)) {
+			m_dropped.fetch_add(1U, std::memory_order_relaxed);
+			if (!m_overflowing)
+				LogWarning("%s queue overflow, dropping old frames, %u dropped so far", m_name, m_dropped.load(std::memory_order_relaxed));
+			m_overflowing = true;
+		}
+	} else {
+		m_overflowing = false;
+	}
+
+	if (length > sizeof(CDMRFrame))
+		length = sizeof(CDMRFrame);
+
+	unsigned char* frame = (unsigned char*)&m_frames[tail & m_mask];
+	::memcpy(frame, data, length);
+	if (length < sizeof(CDMRFrame))
+		::memset(frame + length, 0x00U, sizeof(CDMRFrame) - length);
+
+	m_tail.store(tail + 1U, std::memory_order_release);
+
+	return true;
+}
+
+bool CFrameQueue::getData(CDMRFrame& frame)
+{
+	for (;;) {
+		unsigned int head = m_head.load(std::memory_order_acquire);
+		unsigned int tail = m_tail.load(std::memory_order_acquire);
+		if (head == tail)
+			return false;
+
+		::memcpy(&frame, &m_frames[head & m_mask], sizeof(CDMRFrame));
+
+		if (m_overflow == FQO_DROP_NEWEST) {
+			m_head.store(head + 1U, std::memory_order_release);
+			return true;
+		}
+
+		// If the producer dropped this frame while it was being copied, the
+		// copy may be damaged so go round again
+		if (m_head.compare_exchange_strong(head, head + 1U))
+			return true;
+	}
+}
+
+bool CFrameQueue::isEmpty() const
+{
+	return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
+
+unsigned int CFrameQueue::dataSize() const
+{
+	// Read the head first, the tail can then never be behind it
+	unsigned int head = m_head.load(std::memory_order_acquire);
+	unsigned int tail = m_tail.load(std::memory_order_acquire);
+
+	return tail - head;
+}
+
+unsigned int CFrameQueue::getDropped() const
+{
+	return m_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,72 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(FrameQueue_H)
+#define	FrameQueue_H
+
+#include "DMRData.h"
+
+#include <atomic>
+
+enum FRAMEQUEUE_OVERFLOW {
+	FQO_DROP_NEWEST,
+	FQO_DROP_OLDEST
+};
+
+// A queue of HomeBrew DMRD frames for one producer and one consumer, which
+// may be on different threads. The length is rounded up to a power of two and
+// whole frames are copied in and out. When it is full either the new frame is
+// refused, or the oldest one waiting is thrown away to make room for it.
+class CFrameQueue {
+public:
+	CFrameQueue(unsigned int length, FRAMEQUEUE_OVERFLOW overflow, const char* name);
+	~CFrameQueue();
+
+	// Called by the producer, frames shorter than a CDMRFrame are padded with zeros
+	bool addData(const unsigned char* data, unsigned int length);
+
+	// Called by the consumer
+	bool getData(CDMRFrame& frame);
+
+	bool isEmpty() const;
+
+	unsigned int dataSize() const;
+
+	unsigned int getDropped() const;
+
+private:
+	static const unsigned int CACHE_LINE = 64U;
+
+	unsigned int              m_length;
+	unsigned int              m_mask;
+	FRAMEQUEUE_OVERFLOW       m_overflow;
+	const char*               m_name;
+	CDMRFrame*                m_frames;
+	bool                      m_overflowing;
+	std::atomic<unsigned int> m_dropped;
+
+	// Keep the two indexes on their own cache lines
+	char                      m_pad1[CACHE_LINE];
+	std::atomic<unsigned int> m_head;
+	char                      m_pad2[CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+	std::atomic<unsigned int> m_tail;
+	char                      m_pad3[CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+};
+
+#endif
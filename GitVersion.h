@@ -0,0 +1 @@
+const char *gitversion = "56bd926a0d2b254b641c8480f2a88cf26f207a2a";
@@ -205,34 +205,18 @@ const unsigned int DECODING_TABLE_1987[] =
 	 0x20120U, 0x40600U, 0x20122U, 0x40602U, 0x11009U, 0x11008U, 0x22800U, 0x04110U, 0x1100DU, 0x1100CU, 0x22804U, 0x04114U, 0x11001U, 
 	 0x11000U, 0x11003U, 0x11002U, 0x11005U, 0x11004U, 0x28081U, 0x28080U};
 
-#define X18             0x00040000   /* vector representation of X^{18} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK8           0xfffff800   /* auxiliary vector for testing */
-#define GENPOL          0x00000c75   /* generator polinomial, g(x) */
-
-unsigned int CGolay2087::getSyndrome1987(unsigned int pattern)
-/*
- * Compute the syndrome corresponding to the given pattern, i.e., the
- * remainder after dividing the pattern (when considering it as the vector
- * representation of a polynomial) by the generator polynomial, GENPOL.
- * In the program this pattern has several meanings: (1) pattern = infomation
- * bits, when constructing the encoding table; (2) pattern = error pattern,
- * when constructing the decoding table; and (3) pattern = received vector, to
- * obtain its syndrome in decoding.
- */
+// The check bits of the encoding table, as found in the second and third bytes of
+// a code word, are the syndrome of the data byte on its own. The syndrome is
+// linear, so adding the check bits that were received gives the syndrome of the
+// whole code word without any polynomial division.
+static unsigned int getSyndrome1987(const unsigned char* data)
 {
-	unsigned int aux = X18;
- 
-	if (pattern >= X11) {
-		while (pattern & MASK8) {
-			while (!(aux & pattern))
-				aux = aux >> 1;
+	unsigned int cksum = ENCODING_TABLE_2087[data[0U]];
 
-			pattern ^= (aux / X11) * GENPOL;
-		}
-	}
+	unsigned int expected = ((cksum & 0xFFU) << 3) + ((cksum >> 8) >> 5);
+	unsigned int received = (data[1U] << 3) + (data[2U] >> 5);
 
-	return pattern;
+	return expected ^ received;
 }
 
 unsigned char CGolay2087::decode(const unsigned char* data)
@@ -240,15 +224,25 @@ unsigned char CGolay2087::decode(const unsigned char* data)
 	assert(data != NULL);
 
 	unsigned int code = (data[0U] << 11) + (data[1U] << 3) + (data[2U] >> 5);
-	unsigned int syndrome = getSyndrome1987(code);
-	unsigned int error_pattern = DECODING_TABLE_1987[syndrome];
+	unsigned int error_pattern = DECODING_TABLE_1987[getSyndrome1987(data)];
 
-	if (error_pattern != 0x00U)
-		code ^= error_pattern;
+	code ^= error_pattern;
 
 	return code >> 11;
 }
 
+void CGolay2087::decode(const unsigned char* data, unsigned char* values, unsigned int count)
+{
+	assert(data != NULL);
+	assert(values != NULL);
+
+	for (unsigned int i = 0U; i < count; i++, data += 3U) {
+		unsigned int code = (data[0U] << 11) + (data[1U] << 3) + (data[2U] >> 5);
+
+		values[i] = (code ^ DECODING_TABLE_1987[getSyndrome1987(data)]) >> 11;
+	}
+}
+
 void CGolay2087::encode(unsigned char* data)
 {
 	assert(data != NULL);
@@ -25,8 +25,8 @@ public:
 
 	static unsigned char decode(const unsigned char* data);
 
-private:
-	static unsigned int getSyndrome1987(unsigned int pattern);
+	// Decode count code words of three bytes each, one value per code word
+	static void decode(const unsigned char* data, unsigned char* values, unsigned int count);
 };
 
 #endif
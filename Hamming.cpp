@@ -18,332 +18,158 @@
 
 #include "Hamming.h"
 
-#include <cstdio>
-#include <cassert>
 
- // Hamming (15,11,3) check a boolean data array
-bool CHamming::decode15113_1(bool* d)
+// Each parity check as a mask over the code word
+// including its own parity bit, and the bit to flip for each syndrome. A
+// zero entry means that the syndrome cannot be corrected.
+const uint16_t CHECK_15113_1[] = {0x7F08U, 0x78E4U, 0x66D2U, 0x55B1U};
+const uint16_t CORRECT_15113_1[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0800U, 0x0002U, 0x0200U, 0x0040U, 0x2000U,
+	 0x0001U, 0x0100U, 0x0020U, 0x1000U, 0x0010U, 0x0400U, 0x0080U, 0x4000U};
+
+const uint16_t CHECK_15113_2[] = {0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U};
+const uint16_t CORRECT_15113_2[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	 0x0001U, 0x4000U, 0x0100U, 0x2000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const uint16_t CHECK_1393[] = {0x1AC8U, 0x1D64U, 0x1EB2U, 0x1591U};
+const uint16_t CORRECT_1393[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	 0x0001U, 0x0000U, 0x0100U, 0x0000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const uint16_t CHECK_1063[] = {0x0398U, 0x0354U, 0x02E2U, 0x01E1U};
+const uint16_t CORRECT_1063[] =
+	{0x0000U, 0x0008U, 0x0004U, 0x0010U, 0x0002U, 0x0000U, 0x0000U, 0x0200U,
+	 0x0001U, 0x0000U, 0x0000U, 0x0100U, 0x0020U, 0x0080U, 0x0040U, 0x0000U};
+
+const uint16_t CHECK_16114[] = {0xF590U, 0x7AC8U, 0x3D64U, 0xEB22U, 0xA6E1U};
+const uint16_t CORRECT_16114[] =
+	{0x0000U, 0x0010U, 0x0008U, 0x0000U, 0x0004U, 0x0000U, 0x0000U, 0x1000U,
+	 0x0002U, 0x0000U, 0x0000U, 0x4000U, 0x0000U, 0x0100U, 0x0800U, 0x0000U,
+	 0x0001U, 0x0000U, 0x0000U, 0x0080U, 0x0000U, 0x0400U, 0x0040U, 0x0000U,
+	 0x0000U, 0x8000U, 0x0200U, 0x0000U, 0x0020U, 0x0000U, 0x0000U, 0x2000U};
+
+const uint32_t CHECK_17123[] = {0x1E690U, 0x1F348U, 0x0F9A4U, 0x19A42U, 0x1CD21U};
+const uint32_t CORRECT_17123[] =
+	{0x00000U, 0x00010U, 0x00008U, 0x00000U, 0x00004U, 0x00080U, 0x00000U, 0x02000U,
+	 0x00002U, 0x00000U, 0x00040U, 0x00200U, 0x00000U, 0x00000U, 0x01000U, 0x00000U,
+	 0x00001U, 0x00400U, 0x00000U, 0x00000U, 0x00020U, 0x00000U, 0x00100U, 0x04000U,
+	 0x00000U, 0x00000U, 0x00000U, 0x10000U, 0x00800U, 0x00000U, 0x00000U, 0x08000U};
+
+static unsigned int parity(uint32_t v)
 {
-	assert(d != NULL);
-
-	// Calculate the parity it should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-	bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-	bool c2 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-	bool c3 = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
-
-	unsigned char n = 0U;
-	n |= (c0 != d[11]) ? 0x01U : 0x00U;
-	n |= (c1 != d[12]) ? 0x02U : 0x00U;
-	n |= (c2 != d[13]) ? 0x04U : 0x00U;
-	n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-	switch (n)
-	{
-		// Parity bit errors
-		case 0x01U: d[11] = !d[11]; return true;
-		case 0x02U: d[12] = !d[12]; return true;
-		case 0x04U: d[13] = !d[13]; return true;
-		case 0x08U: d[14] = !d[14]; return true;
-
-		// Data bit errors
-		case 0x0FU: d[0]  = !d[0];  return true;
-		case 0x07U: d[1]  = !d[1];  return true;
-		case 0x0BU: d[2]  = !d[2];  return true;
-		case 0x03U: d[3]  = !d[3];  return true;
-		case 0x0DU: d[4]  = !d[4];  return true;
-		case 0x05U: d[5]  = !d[5];  return true;
-		case 0x09U: d[6]  = !d[6];  return true;
-		case 0x0EU: d[7]  = !d[7];  return true;
-		case 0x06U: d[8]  = !d[8];  return true;
-		case 0x0AU: d[9]  = !d[9];  return true;
-		case 0x0CU: d[10] = !d[10]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	v ^= v >> 16;
+	v ^= v >> 8;
+	v ^= v >> 4;
+
+	return (0x6996U >> (v & 0x0FU)) & 0x01U;
+}
+
+// Each bit of the syndrome is the result of one check, the first in bit 0
+template <class T>
+static unsigned int syndrome(T d, const T* checks, unsigned int count)
+{
+	unsigned int n = 0U;
+	for (unsigned int i = 0U; i < count; i++)
+		n |= parity(d & checks[i]) << i;
+
+	return n;
 }
 
-void CHamming::encode15113_1(bool* d)
+// The parity bits are the last ones in the word, the first check in the highest of them
+template <class T>
+static T encode(T d, const T* checks, unsigned int count)
 {
-	assert(d != NULL);
+	d &= ~((1U << count) - 1U);
+
+	for (unsigned int i = 0U; i < count; i++)
+		d |= parity(d & checks[i]) << (count - 1U - i);
 
-	// Calculate the checksum this row should have
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-	d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-	d[13] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-	d[14] = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
+	return d;
 }
 
-// Hamming (15,11,3) check a boolean data array
-bool CHamming::decode15113_2(bool* d)
+uint16_t CHamming::encode15113_1(uint16_t d)
 {
-	assert(d != NULL);
-
-	// Calculate the checksum this row should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-
-	unsigned char n = 0x00U;
-	n |= (c0 != d[11]) ? 0x01U : 0x00U;
-	n |= (c1 != d[12]) ? 0x02U : 0x00U;
-	n |= (c2 != d[13]) ? 0x04U : 0x00U;
-	n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[11] = !d[11]; return true;
-		case 0x02U: d[12] = !d[12]; return true;
-		case 0x04U: d[13] = !d[13]; return true;
-		case 0x08U: d[14] = !d[14]; return true;
-
-		// Data bit errors
-		case 0x09U: d[0]  = !d[0];  return true;
-		case 0x0BU: d[1]  = !d[1];  return true;
-		case 0x0FU: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x05U: d[5]  = !d[5];  return true;
-		case 0x0AU: d[6]  = !d[6];  return true;
-		case 0x0DU: d[7]  = !d[7];  return true;
-		case 0x03U: d[8]  = !d[8];  return true;
-		case 0x06U: d[9]  = !d[9];  return true;
-		case 0x0CU: d[10] = !d[10]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	return encode<uint16_t>(d, CHECK_15113_1, 4U);
 }
 
-void CHamming::encode15113_2(bool* d)
+bool CHamming::decode15113_1(uint16_t& d)
 {
-	assert(d != NULL);
+	uint16_t correction = CORRECT_15113_1[syndrome<uint16_t>(d, CHECK_15113_1, 4U)];
+	d ^= correction;
 
-	// Calculate the checksum this row should have
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+	return correction != 0U;
 }
 
-// Hamming (13,9,3) check a boolean data array
-bool CHamming::decode1393(bool* d)
+uint16_t CHamming::encode15113_2(uint16_t d)
 {
-	assert(d != NULL);
-
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-	bool c1 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-	bool c2 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c3 = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
-	
-	unsigned char n = 0x00U;
-	n |= (c0 != d[9])  ? 0x01U : 0x00U;
-	n |= (c1 != d[10]) ? 0x02U : 0x00U;
-	n |= (c2 != d[11]) ? 0x04U : 0x00U;
-	n |= (c3 != d[12]) ? 0x08U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[9]  = !d[9];  return true;
-		case 0x02U: d[10] = !d[10]; return true;
-		case 0x04U: d[11] = !d[11]; return true;
-		case 0x08U: d[12] = !d[12]; return true;
-
-		// Data bit erros
-		case 0x0FU: d[0] = !d[0]; return true;
-		case 0x07U: d[1] = !d[1]; return true;
-		case 0x0EU: d[2] = !d[2]; return true;
-		case 0x05U: d[3] = !d[3]; return true;
-		case 0x0AU: d[4] = !d[4]; return true;
-		case 0x0DU: d[5] = !d[5]; return true;
-		case 0x03U: d[6] = !d[6]; return true;
-		case 0x06U: d[7] = !d[7]; return true;
-		case 0x0CU: d[8] = !d[8]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	return encode<uint16_t>(d, CHECK_15113_2, 4U);
 }
 
-void CHamming::encode1393(bool* d)
+bool CHamming::decode15113_2(uint16_t& d)
 {
-	assert(d != NULL);
+	uint16_t correction = CORRECT_15113_2[syndrome<uint16_t>(d, CHECK_15113_2, 4U)];
+	d ^= correction;
 
-	// Calculate the checksum this column should have
-	d[9]  = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-	d[10] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+	return correction != 0U;
 }
 
-// Hamming (10,6,3) check a boolean data array
-bool CHamming::decode1063(bool* d)
+uint16_t CHamming::encode1393(uint16_t d)
 {
-	assert(d != NULL);
-
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[5];
-	bool c1 = d[0] ^ d[1] ^ d[3] ^ d[5];
-	bool c2 = d[0] ^ d[2] ^ d[3] ^ d[4];
-	bool c3 = d[1] ^ d[2] ^ d[3] ^ d[4];
-
-	unsigned char n = 0x00U;
-	n |= (c0 != d[6]) ? 0x01U : 0x00U;
-	n |= (c1 != d[7]) ? 0x02U : 0x00U;
-	n |= (c2 != d[8]) ? 0x04U : 0x00U;
-	n |= (c3 != d[9]) ? 0x08U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[6] = !d[6]; return true;
-		case 0x02U: d[7] = !d[7]; return true;
-		case 0x04U: d[8] = !d[8]; return true;
-		case 0x08U: d[9] = !d[9]; return true;
-
-		// Data bit erros
-		case 0x07U: d[0] = !d[0]; return true;
-		case 0x0BU: d[1] = !d[1]; return true;
-		case 0x0DU: d[2] = !d[2]; return true;
-		case 0x0EU: d[3] = !d[3]; return true;
-		case 0x0CU: d[4] = !d[4]; return true;
-		case 0x03U: d[5] = !d[5]; return true;
-
-		// No bit errors
-		default: return false;
-	}
+	return encode<uint16_t>(d, CHECK_1393, 4U);
 }
 
-void CHamming::encode1063(bool* d)
+bool CHamming::decode1393(uint16_t& d)
 {
-	assert(d != NULL);
+	uint16_t correction = CORRECT_1393[syndrome<uint16_t>(d, CHECK_1393, 4U)];
+	d ^= correction;
 
-	// Calculate the checksum this column should have
-	d[6] = d[0] ^ d[1] ^ d[2] ^ d[5];
-	d[7] = d[0] ^ d[1] ^ d[3] ^ d[5];
-	d[8] = d[0] ^ d[2] ^ d[3] ^ d[4];
-	d[9] = d[1] ^ d[2] ^ d[3] ^ d[4];
+	return correction != 0U;
 }
 
-// A Hamming (16,11,4) Check
-bool CHamming::decode16114(bool* d)
+uint16_t CHamming::encode1063(uint16_t d)
 {
-	assert(d != NULL);
-
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-	bool c4 = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
-
-	// Compare these with the actual bits
-	unsigned char n = 0x00U;
-	n |= (c0 != d[11]) ? 0x01U : 0x00U;
-	n |= (c1 != d[12]) ? 0x02U : 0x00U;
-	n |= (c2 != d[13]) ? 0x04U : 0x00U;
-	n |= (c3 != d[14]) ? 0x08U : 0x00U;
-	n |= (c4 != d[15]) ? 0x10U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[11] = !d[11]; return true;
-		case 0x02U: d[12] = !d[12]; return true;
-		case 0x04U: d[13] = !d[13]; return true;
-		case 0x08U: d[14] = !d[14]; return true;
-		case 0x10U: d[15] = !d[15]; return true;
-
-		// Data bit errors
-		case 0x19U: d[0]  = !d[0];  return true;
-		case 0x0BU: d[1]  = !d[1];  return true;
-		case 0x1FU: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x15U: d[5]  = !d[5];  return true;
-		case 0x1AU: d[6]  = !d[6];  return true;
-		case 0x0DU: d[7]  = !d[7];  return true;
-		case 0x13U: d[8]  = !d[8];  return true;
-		case 0x16U: d[9]  = !d[9];  return true;
-		case 0x1CU: d[10] = !d[10]; return true;
-
-		// No bit errors
-		case 0x00U: return true;
-
-		// Unrecoverable errors
-		default: return false;
-	}
+	return encode<uint16_t>(d, CHECK_1063, 4U);
 }
 
-void CHamming::encode16114(bool* d)
+bool CHamming::decode1063(uint16_t& d)
 {
-	assert(d != NULL);
+	uint16_t correction = CORRECT_1063[syndrome<uint16_t>(d, CHECK_1063, 4U)];
+	d ^= correction;
 
-	d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-	d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-	d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-	d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-	d[15] = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+	return correction != 0U;
 }
 
-// A Hamming (17,12,3) Check
-bool CHamming::decode17123(bool* d)
+uint16_t CHamming::encode16114(uint16_t d)
 {
-	assert(d != NULL);
-
-	// Calculate the checksum this column should have
-	bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-	bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-	bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-	bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-	bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
-
-	// Compare these with the actual bits
-	unsigned char n = 0x00U;
-	n |= (c0 != d[12]) ? 0x01U : 0x00U;
-	n |= (c1 != d[13]) ? 0x02U : 0x00U;
-	n |= (c2 != d[14]) ? 0x04U : 0x00U;
-	n |= (c3 != d[15]) ? 0x08U : 0x00U;
-	n |= (c4 != d[16]) ? 0x10U : 0x00U;
-
-	switch (n) {
-		// Parity bit errors
-		case 0x01U: d[12] = !d[12]; return true;
-		case 0x02U: d[13] = !d[13]; return true;
-		case 0x04U: d[14] = !d[14]; return true;
-		case 0x08U: d[15] = !d[15]; return true;
-		case 0x10U: d[16] = !d[16]; return true;
-
-		// Data bit errors
-		case 0x1BU: d[0]  = !d[0];  return true;
-		case 0x1FU: d[1]  = !d[1];  return true;
-		case 0x17U: d[2]  = !d[2];  return true;
-		case 0x07U: d[3]  = !d[3];  return true;
-		case 0x0EU: d[4]  = !d[4];  return true;
-		case 0x1CU: d[5]  = !d[5];  return true;
-		case 0x11U: d[6]  = !d[6];  return true;
-		case 0x0BU: d[7]  = !d[7];  return true;
-		case 0x16U: d[8]  = !d[8];  return true;
-		case 0x05U: d[9]  = !d[9];  return true;
-		case 0x0AU: d[10] = !d[10]; return true;
-		case 0x14U: d[11] = !d[11]; return true;
-
-		// No bit errors
-		case 0x00U: return true;
-
-		// Unrecoverable errors
-		default: return false;
-	}
+	return encode<uint16_t>(d, CHECK_16114, 5U);
 }
 
-void CHamming::encode17123(bool* d)
+bool CHamming::decode16114(uint16_t& d)
 {
-	assert(d != NULL);
+	unsigned int n = syndrome<uint16_t>(d, CHECK_16114, 5U);
+	if (n == 0U)
+		return true;
+
+	uint16_t correction = CORRECT_16114[n];
+	d ^= correction;
+
+	return correction != 0U;
+}
+
+uint32_t CHamming::encode17123(uint32_t d)
+{
+	return encode<uint32_t>(d, CHECK_17123, 5U);
+}
+
+bool CHamming::decode17123(uint32_t& d)
+{
+	unsigned int n = syndrome<uint32_t>(d, CHECK_17123, 5U);
+	if (n == 0U)
+		return true;
+
+	uint32_t correction = CORRECT_17123[n];
+	d ^= correction;
 
-	d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-	d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-	d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-	d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-	d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+	return correction != 0U;
 }
@@ -19,25 +19,31 @@
 #ifndef	Hamming_H
 #define	Hamming_H
 
+#include <cstdint>
+
 class CHamming {
 public:
-	static void encode15113_1(bool* d);
-	static bool decode15113_1(bool* d);
+	// The code word is packed with its first bit in the most significant bit.
+	// Encoding replaces the parity bits, and decoding corrects the word in
+	// place. The distance 3 decoders return true if they corrected a bit, and
+	// decode16114() and decode17123() return true if the word is now valid.
+	static uint16_t encode15113_1(uint16_t d);
+	static bool     decode15113_1(uint16_t& d);
 
-	static void encode15113_2(bool* d);
-	static bool decode15113_2(bool* d);
+	static uint16_t encode15113_2(uint16_t d);
+	static bool     decode15113_2(uint16_t& d);
 
-	static void encode1393(bool* d);
-	static bool decode1393(bool* d);
+	static uint16_t encode1393(uint16_t d);
+	static bool     decode1393(uint16_t& d);
 
-	static void encode1063(bool* d);
-	static bool decode1063(bool* d);
+	static uint16_t encode1063(uint16_t d);
+	static bool     decode1063(uint16_t& d);
 
-	static void encode16114(bool* d);
-	static bool decode16114(bool* d);
+	static uint16_t encode16114(uint16_t d);
+	static bool     decode16114(uint16_t& d);
 
-	static void encode17123(bool* d);
-	static bool decode17123(bool* d);
+	static uint32_t encode17123(uint32_t d);
+	static bool     decode17123(uint32_t& d);
 };
 
 #endif
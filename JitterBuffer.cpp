@@ -0,0 +1,301 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "JitterBuffer.h"
+#include "DMRDefines.h"
+#include "DMREMB.h"
+#include "Sync.h"
+#include "Log.h"
+
+#include <cstring>
+#include <cassert>
+
+// The same AMBE silence as the voice announcements use
+const unsigned char SILENCE[] = {0xACU, 0xAAU, 0x40U, 0x20U, 0x00U, 0x44U, 0x40U, 0x80U, 0x80U};
+
+// A stream that has sent nothing for this long has ended
+const unsigned int STREAM_TIMEOUT = 1000U;
+
+CJitterBuffer::CJitterBuffer(const std::string& name, unsigned int slotNo, unsigned int delay) :
+m_name(name),
+m_slotNo(slotNo),
+m_delay(delay),
+m_frames(NULL),
+m_present(NULL),
+m_count(0U),
+m_running(false),
+m_playing(false),
+m_underrun(false),
+m_streamId(0U),
+m_nextSeqNo(0U),
+m_highSeqNo(0U),
+m_stopWatch(),
+m_released(0U),
+m_lastArrival(0U),
+m_last(),
+m_colorCode(0U),
+m_late(0U),
+m_lost(0U),
+m_reordered(0U),
+m_duplicates(0U)
+{
+	assert(slotNo == 1U || slotNo == 2U);
+
+	m_frames  = new CDMRData[LENGTH];
+	m_present = new bool[LENGTH];
+
+	clear();
+}
+
+CJitterBuffer::~CJitterBuffer()
+{
+	delete[] m_frames;
+	delete[] m_present;
+}
+
+bool CJitterBuffer::addData(const CDMRData& data)
+{
+	if (data.getStreamId() != m_streamId) {
+		if (m_running)
+			end();
+
+		start(data);
+	} else if (!m_running) {
+		// A straggler from a stream that has already ended
+		return false;
+	}
+
+	unsigned char seqNo = data.getSeqNo();
+
+	// How far ahead of the next frame to be released this one is
+	unsigned char offset = seqNo - m_nextSeqNo;
+
+	if (offset >= 128U) {
+		// Until playing starts an earlier frame may still take the lead
+		unsigned char behind = m_highSeqNo - seqNo;
+		if (m_playing || behind >= LENGTH) {
+			m_late++;
+			return false;
+		}
+
+		m_nextSeqNo = seqNo;
+	} else if (offset >= LENGTH) {
+		// Too far ahead to hold, so give up on everything before it
+		m_lost += offset;
+		clear();
+
+		m_nextSeqNo = seqNo;
+		m_highSeqNo = seqNo - 1U;
+		m_underrun  = true;
+	}
+
+	unsigned int index = seqNo % LENGTH;
+	if (m_present[index]) {
+		m_duplicates++;
+		return false;
+	}
+
+	unsigned char ahead = seqNo - m_highSeqNo;
+	if (ahead >= 128U)
+		m_reordered++;
+	else
+		m_highSeqNo = seqNo;
+
+	m_frames[index]  = data;
+	m_present[index] = true;
+	m_count++;
+
+	if (data.getDataType() == DT_VOICE) {
+		unsigned char buffer[DMR_FRAME_LENGTH_BYTES];
+		data.getData(buffer);
+
+		CDMREMB emb;
+		emb.putData(buffer);
+		m_colorCode = emb.getColorCode();
+	}
+
+	// After running dry the timing starts again from here, so that what
+	// follows is not released in a rush to catch up
+	if (m_underrun) {
+		m_stopWatch.start();
+		m_released = 0U;
+		m_underrun = false;
+	}
+
+	m_lastArrival = m_stopWatch.elapsed();
+
+	return true;
+}
+
+bool CJitterBuffer::getData(CDMRData& data)
+{
+	if (!m_running)
+		return false;
+
+	unsigned int elapsed = m_stopWatch.elapsed();
+
+	while (elapsed >= (m_delay + m_released * DMR_SLOT_TIME)) {
+		if (m_count == 0U) {
+			if ((elapsed - m_lastArrival) >= STREAM_TIMEOUT)
+				end();
+			else
+				m_underrun = true;
+
+			return false;
+		}
+
+		unsigned char seqNo = m_nextSeqNo;
+		unsigned int index  = seqNo % LENGTH;
+
+		m_nextSeqNo++;
+		m_released++;
+
+		if (m_present[index]) {
+			data = m_frames[index];
+			m_present[index] = false;
+			m_count--;
+
+			m_last    = data;
+			m_playing = true;
+
+			return true;
+		}
+
+		// The frames after this one are here, so it is not coming
+		m_lost++;
+
+		if (createSilence(data, seqNo))
+			return true;
+	}
+
+	return false;
+}
+
+unsigned int CJitterBuffer::getDeadline(unsigned int ms)
+{
+	if (!m_running || m_count == 0U)
+		return ms;
+
+	// The time until the next frame is due to be released
+	unsigned int elapsed = m_stopWatch.elapsed();
+	unsigned int due     = m_delay + m_released * DMR_SLOT_TIME;
+	if (due <= elapsed)
+		return 0U;
+
+	return (due - elapsed) < ms ? (due - elapsed) : ms;
+}
+
+void CJitterBuffer::reset()
+{
+	if (m_running)
+		end();
+
+	m_streamId = 0U;
+}
+
+void CJitterBuffer::start(const CDMRData& data)
+{
+	clear();
+
+	m_running   = true;
+	m_playing   = false;
+	m_underrun  = false;
+	m_streamId  = data.getStreamId();
+	m_nextSeqNo = data.getSeqNo();
+	m_highSeqNo = data.getSeqNo() - 1U;
+	m_released  = 0U;
+	m_colorCode = 0U;
+
+	m_late       = 0U;
+	m_lost       = 0U;
+	m_reordered  = 0U;
+	m_duplicates = 0U;
+
+	m_stopWatch.start();
+}
+
+void CJitterBuffer::end()
+{
+	if (m_late > 0U || m_lost > 0U || m_reordered > 0U || m_duplicates > 0U)
+		LogMessage("%s, Slot %u, jitter buffer: %u lost, %u late, %u reordered, %u duplicates", m_name.c_str(), m_slotNo, m_lost, m_late, m_reordered, m_duplicates);
+
+	clear();
+
+	m_running = false;
+}
+
+void CJitterBuffer::clear()
+{
+	for (unsigned int i = 0U; i < LENGTH; i++)
+		m_present[i] = false;
+
+	m_count = 0U;
+}
+
+// Only a voice frame in the middle of a voice stream can be replaced
+bool CJitterBuffer::createSilence(CDMRData& data, unsigned char seqNo)
+{
+	if (!m_playing)
+		return false;
+
+	unsigned char n;
+	unsigned char dataType = m_last.getDataType();
+	if (dataType == DT_VOICE_SYNC)
+		n = 1U;
+	else if (dataType == DT_VOICE)
+		n = (m_last.getN() + 1U) % 6U;
+	else
+		return false;
+
+	data = m_last;
+	data.setSeqNo(seqNo);
+	data.setN(n);
+	data.setDataType(n == 0U ? DT_VOICE_SYNC : DT_VOICE);
+	data.setBER(0U);
+	data.setRSSI(0U);
+
+	unsigned char buffer[DMR_FRAME_LENGTH_BYTES];
+
+	// The second AMBE frame is split around the sync or EMB
+	::memcpy(buffer + 0U,  SILENCE, 9U);
+	::memcpy(buffer + 9U,  SILENCE, 9U);
+	::memcpy(buffer + 15U, SILENCE, 9U);
+	::memcpy(buffer + 24U, SILENCE, 9U);
+
+	if (n == 0U) {
+		CSync::addDMRAudioSync(buffer, true);
+	} else {
+		// An EMB around a null embedded signalling fragment
+		buffer[13U] &= 0xF0U;
+		::memset(buffer + 14U, 0x00U, 5U);
+		buffer[19U] &= 0x0FU;
+
+		CDMREMB emb;
+		emb.setColorCode(m_colorCode);
+		emb.setPI(false);
+		emb.setLCSS(0U);
+		emb.getData(buffer);
+	}
+
+	data.setData(buffer);
+
+	m_last = data;
+
+	return true;
+}
@@ -0,0 +1,83 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(JitterBuffer_H)
+#define	JitterBuffer_H
+
+#include "StopWatch.h"
+#include "DMRData.h"
+
+#include <string>
+
+// Holds back the frames of one slot from a network for a fixed delay, puts
+// them back into sequence number order, and then releases one every slot
+// time. Duplicates and frames that arrive after their turn are dropped, and
+// a missing voice frame is replaced by silence once the frames after it have
+// arrived. Only one stream is followed at a time, a new stream id replaces
+// the old one.
+class CJitterBuffer {
+public:
+	CJitterBuffer(const std::string& name, unsigned int slotNo, unsigned int delay);
+	~CJitterBuffer();
+
+	// Returns false if the frame has been dropped
+	bool addData(const CDMRData& data);
+
+	// Returns true when a frame is due to be released
+	bool getData(CDMRData& data);
+
+	// The time until the next frame is due to be released
+	unsigned int getDeadline(unsigned int ms);
+
+	void reset();
+
+private:
+	static const unsigned int LENGTH = 32U;
+
+	std::string   m_name;
+	unsigned int  m_slotNo;
+	unsigned int  m_delay;
+	CDMRData*     m_frames;
+	bool*         m_present;
+	unsigned int  m_count;
+	bool          m_running;
+	bool          m_playing;
+	bool          m_underrun;
+	unsigned int  m_streamId;
+	unsigned char m_nextSeqNo;
+	unsigned char m_highSeqNo;
+	CStopWatch    m_stopWatch;
+	unsigned int  m_released;
+	unsigned int  m_lastArrival;
+	CDMRData      m_last;
+	unsigned char m_colorCode;
+	unsigned int  m_late;
+	unsigned int  m_lost;
+	unsigned int  m_reordered;
+	unsigned int  m_duplicates;
+
+	void start(const CDMRData& data);
+	void end();
+
+	void clear();
+
+	bool createSilence(CDMRData& data, unsigned char seqNo);
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include <ctime>
 #include <cassert>
 #include <cstring>
+#include <mutex>
 
 static unsigned int m_fileLevel = 2U;
 static std::string m_filePath;
@@ -43,6 +44,9 @@ static struct tm m_tm;
 
 static char LEVELS[] = " DMIWEF";
 
+// The networks may log from their own threads
+static std::mutex m_mutex;
+
 static bool LogOpen()
 {
 	if (m_fileLevel == 0U)
@@ -93,6 +97,8 @@ void Log(unsigned int level, const char* fmt, ...)
 {
     assert(fmt != NULL);
 
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	char buffer[501U];
 #if defined(_WIN32) || defined(_WIN64)
 	SYSTEMTIME st;
@@ -24,22 +24,32 @@
 #include "Log.h"
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
-const unsigned int BUFFER_LENGTH = 500U;
-
 const unsigned int HOMEBREW_DATA_PACKET_LENGTH = 55U;
 
+const unsigned int RX_QUEUE_LENGTH = 16U;
+const unsigned int TX_QUEUE_LENGTH = 20U;
+
+const unsigned int THREAD_WAIT_TIME = 1000U;
 
-CMMDVMNetwork::CMMDVMNetwork(const std::string& rptAddress, unsigned int rptPort, const std::string& localAddress, unsigned int localPort, bool debug) :
+CMMDVMNetwork::CMMDVMNetwork(const std::string& rptAddress, unsigned int rptPort, const std::string& localAddress, unsigned int localPort, unsigned int budget, bool debug) :
+m_rptHost(rptAddress),
 m_rptAddress(),
 m_rptPort(rptPort),
 m_id(0U),
+m_budget(budget),
 m_netId(NULL),
 m_debug(debug),
 m_socket(localAddress, localPort),
-m_buffer(NULL),
-m_rxData(1000U, "MMDVM Network"),
+m_rxBatch(NULL),
+m_rxCount(0U),
+m_rxNext(0U),
+m_txQueue(NULL),
+m_txCount(0U),
+m_rxData(RX_QUEUE_LENGTH + budget, FQO_DROP_OLDEST, "MMDVM Network"),
+m_playout(NULL),
 m_options(),
 m_configData(NULL),
 m_configLen(0U),
@@ -48,16 +58,22 @@ m_radioPositionLen(0U),
 m_talkerAliasData(NULL),
 m_talkerAliasLen(0U),
 m_homePositionData(NULL),
-m_homePositionLen(0U)
+m_homePositionLen(0U),
+m_mutex(),
+m_threaded(false),
+m_stop(false),
+m_threadPoller(),
+m_poller(NULL)
 {
 	assert(!rptAddress.empty());
 	assert(rptPort > 0U);
+	assert(budget > 0U);
 
-	m_rptAddress = CUDPSocket::lookup(rptAddress);
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
 	m_netId  = new unsigned char[4U];
 
+	m_rxBatch = new CUDPDatagram[budget];
+	m_txQueue = new CUDPDatagram[TX_QUEUE_LENGTH];
+
 	m_radioPositionData = new unsigned char[50U];
 	m_talkerAliasData   = new unsigned char[50U];
 	m_homePositionData  = new unsigned char[50U];
@@ -69,20 +85,34 @@ m_homePositionLen(0U)
 CMMDVMNetwork::~CMMDVMNetwork()
 {
 	delete[] m_netId;
-	delete[] m_buffer;
 	delete[] m_configData;
 	delete[] m_radioPositionData;
 	delete[] m_talkerAliasData;
 	delete[] m_homePositionData;
+	delete[] m_rxBatch;
+	delete[] m_txQueue;
+	delete m_playout;
+}
+
+void CMMDVMNetwork::setPlayout(unsigned int depth, FRAMEQUEUE_OVERFLOW overflow)
+{
+	if (depth == 0U)
+		return;
+
+	m_playout = new CPlayoutScheduler("MMDVM Network", depth, overflow);
 }
 
 std::string CMMDVMNetwork::getOptions() const
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	return m_options;
 }
 
 unsigned int CMMDVMNetwork::getConfig(unsigned char* config) const
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_configData == 0U)
 		return 0U;
 
@@ -93,6 +123,8 @@ unsigned int CMMDVMNetwork::getConfig(unsigned char* config) const
 
 unsigned int CMMDVMNetwork::getId() const
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	return m_id;
 }
 
@@ -100,130 +132,111 @@ bool CMMDVMNetwork::open()
 {
 	LogMessage("MMDVM Network, Opening");
 
-	return m_socket.open();
-}
-
-bool CMMDVMNetwork::read(CDMRData& data)
-{
-	if (m_rxData.isEmpty())
+	// Only done at start up, so the lookup is allowed to block
+	bool ret = CUDPSocket::lookup(m_rptHost, m_rptPort, m_rptAddress);
+	if (!ret) {
+		LogError("MMDVM Network, cannot find the address of %s", m_rptHost.c_str());
 		return false;
+	}
 
-	unsigned char length = 0U;
+	return m_socket.open(m_rptAddress.getFamily());
+}
 
-	m_rxData.getData(&length, 1U);
-	m_rxData.getData(m_buffer, length);
+bool CMMDVMNetwork::startThread(CPoller* poller)
+{
+	assert(poller != NULL);
 
-	// Is this a data packet?
-	if (::memcmp(m_buffer, "DMRD", 4U) != 0)
+	bool ret = m_threadPoller.open();
+	if (!ret)
 		return false;
 
-	unsigned char seqNo = m_buffer[4U];
+	m_poller   = poller;
+	m_stop     = false;
+	m_threaded = true;
 
-	unsigned int srcId = (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
+	ret = run();
+	if (!ret) {
+		LogError("MMDVM Network, Unable to start the network thread");
+		m_threaded = false;
+		m_threadPoller.close();
+		return false;
+	}
 
-	unsigned int dstId = (m_buffer[8U] << 16) | (m_buffer[9U] << 8) | (m_buffer[10U] << 0);
+	return true;
+}
 
-	unsigned int slotNo = (m_buffer[15U] & 0x80U) == 0x80U ? 2U : 1U;
+void CMMDVMNetwork::entry()
+{
+	LogMessage("MMDVM Network, Started the network thread");
 
-	FLCO flco = (m_buffer[15U] & 0x40U) == 0x40U ? FLCO_USER_USER : FLCO_GROUP;
+	while (!m_stop) {
+		bool received = false;
+		unsigned int timeout = THREAD_WAIT_TIME;
+		int fd = -1;
 
-	unsigned int streamId;
-	::memcpy(&streamId, m_buffer + 16U, 4U);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
 
-	unsigned char ber = m_buffer[53U];
+			// While something is waiting to be collected, wait to be woken up
+			// by the read rather than reading any more
+			if (!isHolding()) {
+				received = process();
 
-	unsigned char rssi = m_buffer[54U];
+				if (!isHolding()) {
+					fd = m_socket.getFd();
+					if (m_rxNext < m_rxCount)
+						timeout = 0U;
+				}
+			}
 
-	data.setSeqNo(seqNo);
-	data.setSlotNo(slotNo);
-	data.setSrcId(srcId);
-	data.setDstId(dstId);
-	data.setFLCO(flco);
-	data.setStreamId(streamId);
-	data.setBER(ber);
-	data.setRSSI(rssi);
+			send();
+		}
 
-	bool dataSync = (m_buffer[15U] & 0x20U) == 0x20U;
-	bool voiceSync = (m_buffer[15U] & 0x10U) == 0x10U;
+		if (received)
+			m_poller->wakeup();
 
-	if (dataSync) {
-		unsigned char dataType = m_buffer[15U] & 0x0FU;
-		data.setData(m_buffer + 20U);
-		data.setDataType(dataType);
-		data.setN(0U);
-	} else if (voiceSync) {
-		data.setData(m_buffer + 20U);
-		data.setDataType(DT_VOICE_SYNC);
-		data.setN(0U);
-	} else {
-		unsigned char n = m_buffer[15U] & 0x0FU;
-		data.setData(m_buffer + 20U);
-		data.setDataType(DT_VOICE);
-		data.setN(n);
+		m_threadPoller.wait(&fd, 1U, timeout);
 	}
 
-	return true;
+	LogMessage("MMDVM Network, Stopped the network thread");
 }
 
-bool CMMDVMNetwork::write(const CDMRData& data)
+bool CMMDVMNetwork::read(CDMRData& data)
 {
-	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
-	::memset(buffer, 0x00U, HOMEBREW_DATA_PACKET_LENGTH);
-
-	buffer[0U]  = 'D';
-	buffer[1U]  = 'M';
-	buffer[2U]  = 'R';
-	buffer[3U]  = 'D';
-
-	unsigned int srcId = data.getSrcId();
-	buffer[5U]  = srcId >> 16;
-	buffer[6U]  = srcId >> 8;
-	buffer[7U]  = srcId >> 0;
-
-	unsigned int dstId = data.getDstId();
-	buffer[8U]  = dstId >> 16;
-	buffer[9U]  = dstId >> 8;
-	buffer[10U] = dstId >> 0;
-
-	::memcpy(buffer + 11U, m_netId, 4U);
-
-	unsigned int slotNo = data.getSlotNo();
-
-	buffer[15U] = slotNo == 1U ? 0x00U : 0x80U;
-
-	FLCO flco = data.getFLCO();
-	buffer[15U] |= flco == FLCO_GROUP ? 0x00U : 0x40U;
+	CDMRFrame frame;
+	if (!m_rxData.getData(frame))
+		return false;
 
-	unsigned char dataType = data.getDataType();
-	if (dataType == DT_VOICE_SYNC) {
-		buffer[15U] |= 0x10U;
-	} else if (dataType == DT_VOICE) {
-		buffer[15U] |= data.getN();
-	} else {
-		buffer[15U] |= (0x20U | dataType);
-	}
+	return data.setFrame(frame);
+}
 
-	buffer[4U] = data.getSeqNo();
+bool CMMDVMNetwork::write(const CDMRData& data)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
 
-	unsigned int streamId = data.getStreamId();
-	::memcpy(buffer + 16U, &streamId, 4U);
+	if (m_playout != NULL)
+		return m_playout->addData(data);
 
-	data.getData(buffer + 20U);
+	writeData(data);
 
-	buffer[53U] = data.getBER();
+	return true;
+}
 
-	buffer[54U] = data.getRSSI();
+void CMMDVMNetwork::writeData(const CDMRData& data)
+{
+	CDMRFrame frame;
+	data.getFrame(frame, m_netId);
 
 	if (m_debug)
-		CUtils::dump(1U, "Network Transmitted", buffer, HOMEBREW_DATA_PACKET_LENGTH);
-
-	m_socket.write(buffer, HOMEBREW_DATA_PACKET_LENGTH, m_rptAddress, m_rptPort);
+		CUtils::dump(1U, "Network Transmitted", (unsigned char*)&frame, sizeof(CDMRFrame));
 
-	return true;
+	write((unsigned char*)&frame, sizeof(CDMRFrame));
 }
 
 bool CMMDVMNetwork::readRadioPosition(unsigned char* data, unsigned int& length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_radioPositionLen == 0U)
 		return false;
 
@@ -232,11 +245,16 @@ bool CMMDVMNetwork::readRadioPosition(unsigned char* data, unsigned int& length)
 
 	m_radioPositionLen = 0U;
 
+	if (m_threaded)
+		m_threadPoller.wakeup();
+
 	return true;
 }
 
 bool CMMDVMNetwork::readTalkerAlias(unsigned char* data, unsigned int& length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_talkerAliasLen == 0U)
 		return false;
 
@@ -245,11 +263,16 @@ bool CMMDVMNetwork::readTalkerAlias(unsigned char* data, unsigned int& length)
 
 	m_talkerAliasLen = 0U;
 
+	if (m_threaded)
+		m_threadPoller.wakeup();
+
 	return true;
 }
 
 bool CMMDVMNetwork::readHomePosition(unsigned char* data, unsigned int& length)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	if (m_homePositionLen == 0U)
 		return false;
 
@@ -258,19 +281,68 @@ bool CMMDVMNetwork::readHomePosition(unsigned char* data, unsigned int& length)
 
 	m_homePositionLen = 0U;
 
+	if (m_threaded)
+		m_threadPoller.wakeup();
+
 	return true;
 }
 
 bool CMMDVMNetwork::writeBeacon()
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	unsigned char buffer[20U];
 	::memcpy(buffer + 0U, "RPTSBKN", 7U);
 	::memcpy(buffer + 7U, m_netId, 4U);
 
-	return m_socket.write(buffer, 11U, m_rptAddress, m_rptPort);
+	write(buffer, 11U);
+
+	return true;
+}
+
+unsigned int CMMDVMNetwork::getDeadline(unsigned int ms)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_playout != NULL)
+		ms = m_playout->getDeadline(ms);
+
+	if (m_threaded)
+		return ms;
+
+	// Anything left over from the last batch is ready now
+	if (m_rxNext < m_rxCount)
+		return 0U;
+
+	return ms;
+}
+
+int CMMDVMNetwork::getFd() const
+{
+	// The network thread does its own waiting
+	if (m_threaded)
+		return -1;
+
+	return m_socket.getFd();
 }
 
 void CMMDVMNetwork::close()
+{
+	if (m_threaded) {
+		m_stop = true;
+		m_threadPoller.wakeup();
+		wait();
+
+		m_threadPoller.close();
+		m_threaded = false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	disconnect();
+}
+
+void CMMDVMNetwork::disconnect()
 {
 	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
 	::memset(buffer, 0x00U, HOMEBREW_DATA_PACKET_LENGTH);
@@ -280,83 +352,167 @@ void CMMDVMNetwork::close()
 	::memcpy(buffer + 0U, "MSTCL", 5U);
 	::memcpy(buffer + 5U, m_netId, 4U);
 
-	m_socket.write(buffer, HOMEBREW_DATA_PACKET_LENGTH, m_rptAddress, m_rptPort);
+	write(buffer, HOMEBREW_DATA_PACKET_LENGTH);
+	send();
+
 	m_socket.close();
+
+	m_rxCount = 0U;
+	m_rxNext  = 0U;
 }
 
 void CMMDVMNetwork::clock(unsigned int ms)
 {
-	in_addr address;
-	unsigned int port;
-	int length = m_socket.read(m_buffer, BUFFER_LENGTH, address, port);
-	if (length < 0) {
-		LogError("MMDVM Network, Socket has failed, reopening");
-		close();
-		open();
+	if (m_threaded)
 		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	process();
+}
+
+bool CMMDVMNetwork::process()
+{
+	bool received = false;
+
+	// Read everything that is waiting, up to the budget for this pass, unless
+	// some of the previous batch was left behind
+	if (m_rxNext >= m_rxCount) {
+		int count = m_socket.read(m_rxBatch, m_budget);
+		if (count < 0) {
+			LogError("MMDVM Network, Socket has failed, reopening");
+			disconnect();
+			open();
+			return false;
+		}
+
+		m_rxCount = count;
+		m_rxNext  = 0U;
 	}
 
-	// if (m_debug && length > 0)
-	//	CUtils::dump(1U, "Network Received", m_buffer, length);
-
-	if (length > 0 && m_rptAddress.s_addr == address.s_addr && m_rptPort == port) {
-		if (::memcmp(m_buffer, "DMRD", 4U) == 0) {
-			if (m_debug)
-				CUtils::dump(1U, "Network Received", m_buffer, length);
-
-			unsigned char len = length;
-			m_rxData.addData(&len, 1U);
-			m_rxData.addData(m_buffer, len);
-		} else if (::memcmp(m_buffer, "DMRG", 4U) == 0) {
-			::memcpy(m_radioPositionData, m_buffer, length);
-			m_radioPositionLen = length;
-		} else if (::memcmp(m_buffer, "DMRA", 4U) == 0) {
-			::memcpy(m_talkerAliasData, m_buffer, length);
-			m_talkerAliasLen = length;
-		} else if (::memcmp(m_buffer, "RPTG", 4U) == 0) {
-			::memcpy(m_homePositionData, m_buffer, length);
-			m_homePositionLen = length;
-		} else if (::memcmp(m_buffer, "RPTL", 4U) == 0) {
-			m_id = (m_buffer[4U] << 24) | (m_buffer[5U] << 16) | (m_buffer[6U] << 8) | (m_buffer[7U] << 0);
-			::memcpy(m_netId, m_buffer + 4U, 4U);
-
-			unsigned char ack[10U];
-			::memcpy(ack + 0U, "RPTACK", 6U);
-
-			uint32_t salt = 1U;
-			::memcpy(ack + 6U, &salt, sizeof(uint32_t));
-
-			m_socket.write(ack, 10U, m_rptAddress, m_rptPort);
-		} else if (::memcmp(m_buffer, "RPTK", 4U) == 0) {
-			unsigned char ack[10U];
-			::memcpy(ack + 0U, "RPTACK", 6U);
-			::memcpy(ack + 6U, m_netId, 4U);
-			m_socket.write(ack, 10U, m_rptAddress, m_rptPort);
-		} else if (::memcmp(m_buffer, "RPTCL", 5U) == 0) {
-			::LogMessage("MMDVM Network, The connected MMDVM is closing down");
-		} else if (::memcmp(m_buffer, "RPTC", 4U) == 0) {
-			m_configLen = length - 8U;
-			m_configData = new unsigned char[m_configLen];
-			::memcpy(m_configData, m_buffer + 8U, m_configLen);
-
-			unsigned char ack[10U];
-			::memcpy(ack + 0U, "RPTACK", 6U);
-			::memcpy(ack + 6U, m_netId, 4U);
-			m_socket.write(ack, 10U, m_rptAddress, m_rptPort);
-		} else if (::memcmp(m_buffer, "RPTO", 4U) == 0) {
-			m_options = std::string((char*)(m_buffer + 8U), length - 8U);
-
-			unsigned char ack[10U];
-			::memcpy(ack + 0U, "RPTACK", 6U);
-			::memcpy(ack + 6U, m_netId, 4U);
-			m_socket.write(ack, 10U, m_rptAddress, m_rptPort);
-		} else if (::memcmp(m_buffer, "RPTPING", 7U) == 0) {
-			unsigned char pong[11U];
-			::memcpy(pong + 0U, "MSTPONG", 7U);
-			::memcpy(pong + 7U, m_netId, 4U);
-			m_socket.write(pong, 11U, m_rptAddress, m_rptPort);
-		} else {
-			CUtils::dump("Unknown packet from the master", m_buffer, length);
+	while (m_rxNext < m_rxCount) {
+		const CUDPDatagram& datagram = m_rxBatch[m_rxNext++];
+
+		const unsigned char* buffer = datagram.m_data;
+		unsigned int length = datagram.m_length;
+
+		// if (m_debug && length > 0)
+		//	CUtils::dump(1U, "Network Received", buffer, length);
+
+		if (m_rptAddress == datagram.m_address) {
+			if (::memcmp(buffer, "DMRD", 4U) == 0) {
+				if (m_debug)
+					CUtils::dump(1U, "Network Received", buffer, length);
+
+				m_rxData.addData(buffer, length);
+				received = true;
+			} else if (::memcmp(buffer, "DMRG", 4U) == 0) {
+				::memcpy(m_radioPositionData, buffer, length);
+				m_radioPositionLen = length;
+
+				// Only one is held at a time, leave anything else until it has been collected
+				return true;
+			} else if (::memcmp(buffer, "DMRA", 4U) == 0) {
+				::memcpy(m_talkerAliasData, buffer, length);
+				m_talkerAliasLen = length;
+
+				// Only one is held at a time, leave anything else until it has been collected
+				return true;
+			} else if (::memcmp(buffer, "RPTG", 4U) == 0) {
+				::memcpy(m_homePositionData, buffer, length);
+				m_homePositionLen = length;
+
+				// Only one is held at a time, leave anything else until it has been collected
+				return true;
+			} else if (::memcmp(buffer, "RPTL", 4U) == 0) {
+				m_id = (buffer[4U] << 24) | (buffer[5U] << 16) | (buffer[6U] << 8) | (buffer[7U] << 0);
+				::memcpy(m_netId, buffer + 4U, 4U);
+
+				unsigned char ack[10U];
+				::memcpy(ack + 0U, "RPTACK", 6U);
+
+				uint32_t salt = 1U;
+				::memcpy(ack + 6U, &salt, sizeof(uint32_t));
+
+				write(ack, 10U);
+			} else if (::memcmp(buffer, "RPTK", 4U) == 0) {
+				unsigned char ack[10U];
+				::memcpy(ack + 0U, "RPTACK", 6U);
+				::memcpy(ack + 6U, m_netId, 4U);
+				write(ack, 10U);
+			} else if (::memcmp(buffer, "RPTCL", 5U) == 0) {
+				::LogMessage("MMDVM Network, The connected MMDVM is closing down");
+			} else if (::memcmp(buffer, "RPTC", 4U) == 0) {
+				m_configLen = length - 8U;
+				m_configData = new unsigned char[m_configLen];
+				::memcpy(m_configData, buffer + 8U, m_configLen);
+
+				unsigned char ack[10U];
+				::memcpy(ack + 0U, "RPTACK", 6U);
+				::memcpy(ack + 6U, m_netId, 4U);
+				write(ack, 10U);
+			} else if (::memcmp(buffer, "RPTO", 4U) == 0) {
+				m_options = std::string((char*)(buffer + 8U), length - 8U);
+
+				unsigned char ack[10U];
+				::memcpy(ack + 0U, "RPTACK", 6U);
+				::memcpy(ack + 6U, m_netId, 4U);
+				write(ack, 10U);
+			} else if (::memcmp(buffer, "RPTPING", 7U) == 0) {
+				unsigned char pong[11U];
+				::memcpy(pong + 0U, "MSTPONG", 7U);
+				::memcpy(pong + 7U, m_netId, 4U);
+				write(pong, 11U);
+			} else {
+				CUtils::dump("Unknown packet from the master", buffer, length);
+			}
 		}
 	}
+
+	return received;
+}
+
+bool CMMDVMNetwork::isHolding() const
+{
+	return m_radioPositionLen > 0U || m_talkerAliasLen > 0U || m_homePositionLen > 0U;
+}
+
+void CMMDVMNetwork::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_playout != NULL) {
+		CDMRData data;
+		while (m_playout->getData(data))
+			writeData(data);
+	}
+
+	send();
+}
+
+void CMMDVMNetwork::send()
+{
+	if (m_txCount == 0U)
+		return;
+
+	unsigned int count = m_txCount;
+	m_txCount = 0U;
+
+	bool ret = m_socket.write(m_txQueue, count);
+	if (!ret)
+		LogError("MMDVM Network, Socket has failed when writing data to the MMDVM");
+}
+
+void CMMDVMNetwork::write(const unsigned char* data, unsigned int length)
+{
+	assert(data != NULL);
+	assert(length > 0U && length <= UDP_DATAGRAM_LENGTH);
+
+	if (m_txCount == TX_QUEUE_LENGTH)
+		send();
+
+	CUDPDatagram& datagram = m_txQueue[m_txCount++];
+	::memcpy(datagram.m_data, data, length);
+	datagram.m_length  = length;
+	datagram.m_address = m_rptAddress;
 }
@@ -22,18 +22,29 @@
 #include "RepeaterProtocol.h"
 #include "UDPSocket.h"
 #include "Timer.h"
-#include "RingBuffer.h"
+#include "FrameQueue.h"
+#include "PlayoutScheduler.h"
 #include "DMRData.h"
+#include "Poller.h"
+#include "Thread.h"
 
 #include <string>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
 
-class CMMDVMNetwork : public IRepeaterProtocol
+// When started with startThread() the MMDVM is read on its own thread, in the
+// same way as CDMRNetwork.
+class CMMDVMNetwork : public IRepeaterProtocol, public CThread
 {
 public:
-	CMMDVMNetwork(const std::string& rptAddress, unsigned int rptPort, const std::string& localAddress, unsigned int localPort, bool debug);
+	CMMDVMNetwork(const std::string& rptAddress, unsigned int rptPort, const std::string& localAddress, unsigned int localPort, unsigned int budget, bool debug);
 	virtual ~CMMDVMNetwork();
 
+	// Frames to the MMDVM are spaced out by slot, holding up to depth frames
+	// on each, 0 turns it off
+	void setPlayout(unsigned int depth, FRAMEQUEUE_OVERFLOW overflow);
+
 	virtual std::string getOptions() const;
 
 	virtual unsigned int getConfig(unsigned char* config) const;
@@ -42,6 +53,9 @@ public:
 
 	virtual bool open();
 
+	// Wakes up the given poller whenever new data has been received
+	virtual bool startThread(CPoller* poller);
+
 	virtual bool read(CDMRData& data);
 
 	virtual bool write(const CDMRData& data);
@@ -56,17 +70,32 @@ public:
 
 	virtual void clock(unsigned int ms);
 
+	virtual void flush();
+
+	virtual unsigned int getDeadline(unsigned int ms);
+
+	virtual int  getFd() const;
+
 	virtual void close();
 
+	virtual void entry();
+
 private: 
-	in_addr                    m_rptAddress;
+	std::string                m_rptHost;
+	CUDPAddress                m_rptAddress;
 	unsigned int               m_rptPort;
 	unsigned int               m_id;
+	unsigned int               m_budget;
 	unsigned char*             m_netId;
 	bool                       m_debug;
 	CUDPSocket                 m_socket;
-	unsigned char*             m_buffer;
-	CRingBuffer<unsigned char> m_rxData;
+	CUDPDatagram*              m_rxBatch;
+	unsigned int               m_rxCount;
+	unsigned int               m_rxNext;
+	CUDPDatagram*              m_txQueue;
+	unsigned int               m_txCount;
+	CFrameQueue                m_rxData;
+	CPlayoutScheduler*         m_playout;
 	std::string                m_options;
 	unsigned char*             m_configData;
 	unsigned int               m_configLen;
@@ -76,6 +105,19 @@ private:
 	unsigned int               m_talkerAliasLen;
 	unsigned char*             m_homePositionData;
 	unsigned int               m_homePositionLen;
+	mutable std::mutex         m_mutex;
+	bool                       m_threaded;
+	std::atomic<bool>          m_stop;
+	CPoller                    m_threadPoller;
+	CPoller*                   m_poller;
+
+	void write(const unsigned char* data, unsigned int length);
+	void writeData(const CDMRData& data);
+
+	bool process();
+	bool isHolding() const;
+	void send();
+	void disconnect();
 };
 
 #endif
@@ -48,3 +48,15 @@ bool CPassAllPC::process(CDMRData& data, bool trace)
 
 	return ret;
 }
+
+CRewriteMatch CPassAllPC::getMatch() const
+{
+	CRewriteMatch match;
+	match.m_slot    = m_slot;
+	match.m_flco    = FLCO_USER_USER;
+	match.m_srcId   = false;
+	match.m_idStart = 0U;
+	match.m_idEnd   = 0xFFFFFFFFU;
+
+	return match;
+}
@@ -31,6 +31,8 @@ public:
 
 	virtual bool process(CDMRData& data, bool trace);
 
+	virtual CRewriteMatch getMatch() const;
+
 private:
 	std::string  m_name;
 	unsigned int m_slot;
@@ -0,0 +1,134 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "PlayoutScheduler.h"
+#include "DMRDefines.h"
+#include "Log.h"
+
+#include <cassert>
+
+CPlayoutScheduler::CPlayoutScheduler(const char* name, unsigned int depth, FRAMEQUEUE_OVERFLOW overflow) :
+m_name(name),
+m_depth(depth),
+m_overflow(overflow),
+m_stopWatch(),
+m_slots(),
+m_dropped(0U)
+{
+	assert(name != NULL);
+	assert(depth > 0U);
+
+	for (unsigned int i = 1U; i < 3U; i++) {
+		m_slots[i].m_frames      = new CDMRData[depth];
+		m_slots[i].m_head        = 0U;
+		m_slots[i].m_count       = 0U;
+		m_slots[i].m_due         = 0U;
+		m_slots[i].m_overflowing = false;
+	}
+
+	m_stopWatch.start();
+}
+
+CPlayoutScheduler::~CPlayoutScheduler()
+{
+	delete[] m_slots[1U].m_frames;
+	delete[] m_slots[2U].m_frames;
+}
+
+bool CPlayoutScheduler::addData(const CDMRData& data)
+{
+	unsigned int slotNo = data.getSlotNo();
+	CPlayoutSlot& slot  = m_slots[slotNo];
+
+	if (slot.m_count >= m_depth) {
+		m_dropped++;
+
+		if (m_overflow == FQO_DROP_NEWEST) {
+			if (!slot.m_overflowing)
+				LogWarning("%s playout overflow on slot %u, dropping new frames, %u dropped so far", m_name, slotNo, m_dropped);
+			slot.m_overflowing = true;
+			return false;
+		}
+
+		if (!slot.m_overflowing)
+			LogWarning("%s playout overflow on slot %u, dropping old frames, %u dropped so far", m_name, slotNo, m_dropped);
+		slot.m_overflowing = true;
+
+		slot.m_head = (slot.m_head + 1U) % m_depth;
+		slot.m_count--;
+	} else {
+		slot.m_overflowing = false;
+	}
+
+	slot.m_frames[(slot.m_head + slot.m_count) % m_depth] = data;
+	slot.m_count++;
+
+	return true;
+}
+
+bool CPlayoutScheduler::getData(CDMRData& data)
+{
+	unsigned int now = m_stopWatch.elapsed();
+
+	for (unsigned int i = 1U; i < 3U; i++) {
+		CPlayoutSlot& slot = m_slots[i];
+
+		if (slot.m_count == 0U || int(now - slot.m_due) < 0)
+			continue;
+
+		data = slot.m_frames[slot.m_head];
+		slot.m_head = (slot.m_head + 1U) % m_depth;
+		slot.m_count--;
+
+		// Keep to the cadence while the slot is busy, after a gap start again from now
+		if (int(now - slot.m_due) >= int(DMR_SLOT_TIME))
+			slot.m_due = now + DMR_SLOT_TIME;
+		else
+			slot.m_due += DMR_SLOT_TIME;
+
+		return true;
+	}
+
+	return false;
+}
+
+unsigned int CPlayoutScheduler::getDeadline(unsigned int ms)
+{
+	unsigned int now = m_stopWatch.elapsed();
+
+	for (unsigned int i = 1U; i < 3U; i++) {
+		const CPlayoutSlot& slot = m_slots[i];
+		if (slot.m_count == 0U)
+			continue;
+
+		int wait = int(slot.m_due - now);
+		if (wait <= 0)
+			return 0U;
+
+		if ((unsigned int)wait < ms)
+			ms = (unsigned int)wait;
+	}
+
+	return ms;
+}
+
+unsigned int CPlayoutScheduler::getDropped() const
+{
+	return m_dropped;
+}
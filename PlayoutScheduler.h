@@ -0,0 +1,64 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(PlayoutScheduler_H)
+#define	PlayoutScheduler_H
+
+#include "FrameQueue.h"
+#include "StopWatch.h"
+#include "DMRData.h"
+
+// Spaces out the frames going to the MMDVM so that each slot gets no more
+// than one every DMR_SLOT_TIME, whatever the network delivered. Each slot
+// keeps its own time and queue, and when a queue is full either the new
+// frame is refused or the oldest one waiting is thrown away.
+class CPlayoutScheduler {
+public:
+	CPlayoutScheduler(const char* name, unsigned int depth, FRAMEQUEUE_OVERFLOW overflow);
+	~CPlayoutScheduler();
+
+	// Returns false if the frame has been dropped
+	bool addData(const CDMRData& data);
+
+	// Returns true when a frame on either slot is due
+	bool getData(CDMRData& data);
+
+	// The time until the next frame is due
+	unsigned int getDeadline(unsigned int ms);
+
+	unsigned int getDropped() const;
+
+private:
+	struct CPlayoutSlot {
+		CDMRData*    m_frames;
+		unsigned int m_head;
+		unsigned int m_count;
+		unsigned int m_due;
+		bool         m_overflowing;
+	};
+
+	const char*         m_name;
+	unsigned int        m_depth;
+	FRAMEQUEUE_OVERFLOW m_overflow;
+	CStopWatch          m_stopWatch;
+	CPlayoutSlot        m_slots[3U];
+	unsigned int        m_dropped;
+};
+
+#endif
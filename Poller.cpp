@@ -0,0 +1,286 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Poller.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock.h>
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#else
+#include <sys/select.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+
+const unsigned int MAX_EVENTS = 10U;
+
+#if defined(_WIN32) || defined(_WIN64)
+// Windows cannot select() on anything but sockets, so check for a wakeup this often
+const unsigned int WAKEUP_SLICE = 10U;
+#endif
+
+CPoller::CPoller() :
+m_fd(-1),
+m_fds(),
+m_wanted(),
+#if defined(_WIN32) || defined(_WIN64)
+m_woken(false)
+#else
+m_pipe()
+#endif
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+	m_pipe[0U] = -1;
+	m_pipe[1U] = -1;
+#endif
+}
+
+CPoller::~CPoller()
+{
+}
+
+bool CPoller::open()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	m_woken = false;
+#else
+	if (::pipe(m_pipe) < 0) {
+		LogError("Cannot create the poller wakeup pipe, err: %d", errno);
+		return false;
+	}
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		::fcntl(m_pipe[i], F_SETFL, ::fcntl(m_pipe[i], F_GETFL) | O_NONBLOCK);
+		::fcntl(m_pipe[i], F_SETFD, FD_CLOEXEC);
+	}
+#endif
+
+#if defined(__linux__)
+	m_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	if (m_fd < 0) {
+		LogError("Cannot create the epoll instance, err: %d", errno);
+		return false;
+	}
+
+	epoll_event event;
+	event.events  = EPOLLIN;
+	event.data.fd = m_pipe[0U];
+	if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, m_pipe[0U], &event) < 0) {
+		LogError("Cannot add the wakeup pipe to the epoll instance, err: %d", errno);
+		return false;
+	}
+#endif
+
+	m_fds.clear();
+
+	return true;
+}
+
+int CPoller::wait(const int* fds, unsigned int count, unsigned int ms)
+{
+	assert(fds != NULL || count == 0U);
+
+#if defined(__linux__)
+	update(fds, count);
+
+	epoll_event events[MAX_EVENTS];
+	int ret = ::epoll_wait(m_fd, events, MAX_EVENTS, int(ms));
+	if (ret < 0) {
+		if (errno == EINTR)
+			return 0;
+
+		LogError("Error returned from epoll_wait, err: %d", errno);
+		return -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		if (events[i].data.fd == m_pipe[0U])
+			drain();
+	}
+
+	// A socket that was closed and reopened with the same descriptor number
+	// loses its registration, so re-check them when nothing else is happening
+	if (ret == 0) {
+		for (std::vector<int>::const_iterator it = m_fds.begin(); it != m_fds.end(); ++it) {
+			epoll_event event;
+			event.events  = EPOLLIN;
+			event.data.fd = *it;
+			if (::epoll_ctl(m_fd, EPOLL_CTL_MOD, *it, &event) < 0 && errno == ENOENT)
+				::epoll_ctl(m_fd, EPOLL_CTL_ADD, *it, &event);
+		}
+	}
+
+	return ret;
+#else
+	fd_set readFds;
+	FD_ZERO(&readFds);
+
+	int maxFd = -1;
+	for (unsigned int i = 0U; i < count; i++) {
+		if (fds[i] < 0)
+			continue;
+#if defined(_WIN32) || defined(_WIN64)
+		FD_SET((unsigned int)fds[i], &readFds);
+#else
+		FD_SET(fds[i], &readFds);
+#endif
+		if (fds[i] > maxFd)
+			maxFd = fds[i];
+	}
+
+#if defined(_WIN32) || defined(_WIN64)
+	// Wait in short slices so that a wakeup is not missed for long
+	for (;;) {
+		if (m_woken.exchange(false))
+			return 0;
+
+		unsigned int slice = ms < WAKEUP_SLICE ? ms : WAKEUP_SLICE;
+
+		// Windows will not select() on an empty set
+		if (maxFd < 0) {
+			::Sleep(slice);
+		} else {
+			timeval tv;
+			tv.tv_sec  = 0L;
+			tv.tv_usec = slice * 1000U;
+
+			fd_set waitFds = readFds;
+			int ret = ::select(maxFd + 1, &waitFds, NULL, NULL, &tv);
+			if (ret < 0) {
+				LogError("Error returned from select, err: %lu", ::GetLastError());
+				return -1;
+			}
+
+			if (ret > 0)
+				return ret;
+		}
+
+		if (ms <= slice)
+			return 0;
+
+		ms -= slice;
+	}
+#else
+	FD_SET(m_pipe[0U], &readFds);
+	if (m_pipe[0U] > maxFd)
+		maxFd = m_pipe[0U];
+
+	timeval tv;
+	tv.tv_sec  = ms / 1000U;
+	tv.tv_usec = (ms % 1000U) * 1000U;
+
+	int ret = ::select(maxFd + 1, &readFds, NULL, NULL, &tv);
+	if (ret < 0) {
+		if (errno == EINTR)
+			return 0;
+
+		LogError("Error returned from select, err: %d", errno);
+		return -1;
+	}
+
+	if (FD_ISSET(m_pipe[0U], &readFds))
+		drain();
+
+	return ret;
+#endif
+#endif
+}
+
+void CPoller::wakeup()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	m_woken = true;
+#else
+	// If the pipe is full then a wakeup is already pending
+	unsigned char c = 0U;
+	ssize_t ret = ::write(m_pipe[1U], &c, 1U);
+	(void)ret;
+#endif
+}
+
+void CPoller::close()
+{
+#if defined(__linux__)
+	if (m_fd >= 0)
+		::close(m_fd);
+#endif
+
+#if !defined(_WIN32) && !defined(_WIN64)
+	for (unsigned int i = 0U; i < 2U; i++) {
+		if (m_pipe[i] >= 0)
+			::close(m_pipe[i]);
+		m_pipe[i] = -1;
+	}
+#endif
+
+	m_fd = -1;
+	m_fds.clear();
+}
+
+void CPoller::drain()
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+	unsigned char buffer[16U];
+	while (::read(m_pipe[0U], buffer, sizeof(buffer)) > 0)
+		;
+#endif
+}
+
+void CPoller::update(const int* fds, unsigned int count)
+{
+#if defined(__linux__)
+	m_wanted.clear();
+	for (unsigned int i = 0U; i < count; i++) {
+		if (fds[i] >= 0)
+			m_wanted.push_back(fds[i]);
+	}
+
+	std::sort(m_wanted.begin(), m_wanted.end());
+
+	if (m_wanted == m_fds)
+		return;
+
+	// Closed sockets are removed by the kernel, so failures here are expected
+	for (std::vector<int>::const_iterator it = m_fds.begin(); it != m_fds.end(); ++it) {
+		if (!std::binary_search(m_wanted.begin(), m_wanted.end(), *it))
+			::epoll_ctl(m_fd, EPOLL_CTL_DEL, *it, NULL);
+	}
+
+	for (std::vector<int>::const_iterator it = m_wanted.begin(); it != m_wanted.end(); ++it) {
+		if (!std::binary_search(m_fds.begin(), m_fds.end(), *it)) {
+			epoll_event event;
+			event.events  = EPOLLIN;
+			event.data.fd = *it;
+			if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, *it, &event) < 0 && errno != EEXIST)
+				LogError("Cannot add a socket to the epoll instance, err: %d", errno);
+		}
+	}
+
+	m_fds = m_wanted;
+#endif
+}
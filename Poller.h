@@ -0,0 +1,59 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(Poller_H)
+#define	Poller_H
+
+#include <vector>
+#include <atomic>
+
+// Waits for any of a set of sockets to become readable, or for a timeout to
+// expire. Uses epoll on Linux and select() everywhere else. The set of
+// sockets is passed on every call so that sockets which are closed and
+// reopened by the networks are picked up without any extra bookkeeping.
+// Another thread may cut the wait short by calling wakeup().
+class CPoller {
+public:
+	CPoller();
+	~CPoller();
+
+	bool open();
+
+	// Returns the number of readable sockets, 0 on timeout, or -1 on error
+	int  wait(const int* fds, unsigned int count, unsigned int ms);
+
+	void wakeup();
+
+	void close();
+
+private:
+	int               m_fd;
+	std::vector<int>  m_fds;
+	std::vector<int>  m_wanted;
+#if defined(_WIN32) || defined(_WIN64)
+	std::atomic<bool> m_woken;
+#else
+	int               m_pipe[2U];
+#endif
+
+	void drain();
+
+	void update(const int* fds, unsigned int count);
+};
+
+#endif
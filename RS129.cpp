@@ -20,101 +20,108 @@
 
 #include <cstdio>
 #include <cassert>
-#include <cstring>
 
 const unsigned int NPAR = 3U;
 
-/* Maximum degree of various polynomials. */
-const unsigned int MAXDEG = NPAR * 2U;
-
-/* Generator Polynomial */
-const unsigned char POLY[] = {64U, 56U, 14U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U};
-
-const unsigned char EXP_TABLE[] = {
-	0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U, 0x1DU, 0x3AU, 0x74U, 0xE8U, 0xCDU, 0x87U, 0x13U, 0x26U,
-	0x4CU, 0x98U, 0x2DU, 0x5AU, 0xB4U, 0x75U, 0xEAU, 0xC9U, 0x8FU, 0x03U, 0x06U, 0x0CU, 0x18U, 0x30U, 0x60U, 0xC0U,
-	0x9DU, 0x27U, 0x4EU, 0x9CU, 0x25U, 0x4AU, 0x94U, 0x35U, 0x6AU, 0xD4U, 0xB5U, 0x77U, 0xEEU, 0xC1U, 0x9FU, 0x23U,
-	0x46U, 0x8CU, 0x05U, 0x0AU, 0x14U, 0x28U, 0x50U, 0xA0U, 0x5DU, 0xBAU, 0x69U, 0xD2U, 0xB9U, 0x6FU, 0xDEU, 0xA1U,
-	0x5FU, 0xBEU, 0x61U, 0xC2U, 0x99U, 0x2FU, 0x5EU, 0xBCU, 0x65U, 0xCAU, 0x89U, 0x0FU, 0x1EU, 0x3CU, 0x78U, 0xF0U,
-	0xFDU, 0xE7U, 0xD3U, 0xBBU, 0x6BU, 0xD6U, 0xB1U, 0x7FU, 0xFEU, 0xE1U, 0xDFU, 0xA3U, 0x5BU, 0xB6U, 0x71U, 0xE2U,
-	0xD9U, 0xAFU, 0x43U, 0x86U, 0x11U, 0x22U, 0x44U, 0x88U, 0x0DU, 0x1AU, 0x34U, 0x68U, 0xD0U, 0xBDU, 0x67U, 0xCEU,
-	0x81U, 0x1FU, 0x3EU, 0x7CU, 0xF8U, 0xEDU, 0xC7U, 0x93U, 0x3BU, 0x76U, 0xECU, 0xC5U, 0x97U, 0x33U, 0x66U, 0xCCU,
-	0x85U, 0x17U, 0x2EU, 0x5CU, 0xB8U, 0x6DU, 0xDAU, 0xA9U, 0x4FU, 0x9EU, 0x21U, 0x42U, 0x84U, 0x15U, 0x2AU, 0x54U,
-	0xA8U, 0x4DU, 0x9AU, 0x29U, 0x52U, 0xA4U, 0x55U, 0xAAU, 0x49U, 0x92U, 0x39U, 0x72U, 0xE4U, 0xD5U, 0xB7U, 0x73U,
-	0xE6U, 0xD1U, 0xBFU, 0x63U, 0xC6U, 0x91U, 0x3FU, 0x7EU, 0xFCU, 0xE5U, 0xD7U, 0xB3U, 0x7BU, 0xF6U, 0xF1U, 0xFFU,
-	0xE3U, 0xDBU, 0xABU, 0x4BU, 0x96U, 0x31U, 0x62U, 0xC4U, 0x95U, 0x37U, 0x6EU, 0xDCU, 0xA5U, 0x57U, 0xAEU, 0x41U,
-	0x82U, 0x19U, 0x32U, 0x64U, 0xC8U, 0x8DU, 0x07U, 0x0EU, 0x1CU, 0x38U, 0x70U, 0xE0U, 0xDDU, 0xA7U, 0x53U, 0xA6U,
-	0x51U, 0xA2U, 0x59U, 0xB2U, 0x79U, 0xF2U, 0xF9U, 0xEFU, 0xC3U, 0x9BU, 0x2BU, 0x56U, 0xACU, 0x45U, 0x8AU, 0x09U,
-	0x12U, 0x24U, 0x48U, 0x90U, 0x3DU, 0x7AU, 0xF4U, 0xF5U, 0xF7U, 0xF3U, 0xFBU, 0xEBU, 0xCBU, 0x8BU, 0x0BU, 0x16U,
-	0x2CU, 0x58U, 0xB0U, 0x7DU, 0xFAU, 0xE9U, 0xCFU, 0x83U, 0x1BU, 0x36U, 0x6CU, 0xD8U, 0xADU, 0x47U, 0x8EU, 0x01U,
-	0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U, 0x1DU, 0x3AU, 0x74U, 0xE8U, 0xCDU, 0x87U, 0x13U, 0x26U, 0x4CU,
-	0x98U, 0x2DU, 0x5AU, 0xB4U, 0x75U, 0xEAU, 0xC9U, 0x8FU, 0x03U, 0x06U, 0x0CU, 0x18U, 0x30U, 0x60U, 0xC0U, 0x9DU,
-	0x27U, 0x4EU, 0x9CU, 0x25U, 0x4AU, 0x94U, 0x35U, 0x6AU, 0xD4U, 0xB5U, 0x77U, 0xEEU, 0xC1U, 0x9FU, 0x23U, 0x46U,
-	0x8CU, 0x05U, 0x0AU, 0x14U, 0x28U, 0x50U, 0xA0U, 0x5DU, 0xBAU, 0x69U, 0xD2U, 0xB9U, 0x6FU, 0xDEU, 0xA1U, 0x5FU,
-	0xBEU, 0x61U, 0xC2U, 0x99U, 0x2FU, 0x5EU, 0xBCU, 0x65U, 0xCAU, 0x89U, 0x0FU, 0x1EU, 0x3CU, 0x78U, 0xF0U, 0xFDU,
-	0xE7U, 0xD3U, 0xBBU, 0x6BU, 0xD6U, 0xB1U, 0x7FU, 0xFEU, 0xE1U, 0xDFU, 0xA3U, 0x5BU, 0xB6U, 0x71U, 0xE2U, 0xD9U,
-	0xAFU, 0x43U, 0x86U, 0x11U, 0x22U, 0x44U, 0x88U, 0x0DU, 0x1AU, 0x34U, 0x68U, 0xD0U, 0xBDU, 0x67U, 0xCEU, 0x81U,
-	0x1FU, 0x3EU, 0x7CU, 0xF8U, 0xEDU, 0xC7U, 0x93U, 0x3BU, 0x76U, 0xECU, 0xC5U, 0x97U, 0x33U, 0x66U, 0xCCU, 0x85U,
-	0x17U, 0x2EU, 0x5CU, 0xB8U, 0x6DU, 0xDAU, 0xA9U, 0x4FU, 0x9EU, 0x21U, 0x42U, 0x84U, 0x15U, 0x2AU, 0x54U, 0xA8U,
-	0x4DU, 0x9AU, 0x29U, 0x52U, 0xA4U, 0x55U, 0xAAU, 0x49U, 0x92U, 0x39U, 0x72U, 0xE4U, 0xD5U, 0xB7U, 0x73U, 0xE6U,
-	0xD1U, 0xBFU, 0x63U, 0xC6U, 0x91U, 0x3FU, 0x7EU, 0xFCU, 0xE5U, 0xD7U, 0xB3U, 0x7BU, 0xF6U, 0xF1U, 0xFFU, 0xE3U,
-	0xDBU, 0xABU, 0x4BU, 0x96U, 0x31U, 0x62U, 0xC4U, 0x95U, 0x37U, 0x6EU, 0xDCU, 0xA5U, 0x57U, 0xAEU, 0x41U, 0x82U,
-	0x19U, 0x32U, 0x64U, 0xC8U, 0x8DU, 0x07U, 0x0EU, 0x1CU, 0x38U, 0x70U, 0xE0U, 0xDDU, 0xA7U, 0x53U, 0xA6U, 0x51U,
-	0xA2U, 0x59U, 0xB2U, 0x79U, 0xF2U, 0xF9U, 0xEFU, 0xC3U, 0x9BU, 0x2BU, 0x56U, 0xACU, 0x45U, 0x8AU, 0x09U, 0x12U,
-	0x24U, 0x48U, 0x90U, 0x3DU, 0x7AU, 0xF4U, 0xF5U, 0xF7U, 0xF3U, 0xFBU, 0xEBU, 0xCBU, 0x8BU, 0x0BU, 0x16U, 0x2CU,
-	0x58U, 0xB0U, 0x7DU, 0xFAU, 0xE9U, 0xCFU, 0x83U, 0x1BU, 0x36U, 0x6CU, 0xD8U, 0xADU, 0x47U, 0x8EU, 0x01U, 0x00U};
-
-const unsigned char LOG_TABLE[] = {
-	0x00U, 0x00U, 0x01U, 0x19U, 0x02U, 0x32U, 0x1AU, 0xC6U, 0x03U, 0xDFU, 0x33U, 0xEEU, 0x1BU, 0x68U, 0xC7U, 0x4BU,
-	0x04U, 0x64U, 0xE0U, 0x0EU, 0x34U, 0x8DU, 0xEFU, 0x81U, 0x1CU, 0xC1U, 0x69U, 0xF8U, 0xC8U, 0x08U, 0x4CU, 0x71U,
-	0x05U, 0x8AU, 0x65U, 0x2FU, 0xE1U, 0x24U, 0x0FU, 0x21U, 0x35U, 0x93U, 0x8EU, 0xDAU, 0xF0U, 0x12U, 0x82U, 0x45U,
-	0x1DU, 0xB5U, 0xC2U, 0x7DU, 0x6AU, 0x27U, 0xF9U, 0xB9U, 0xC9U, 0x9AU, 0x09U, 0x78U, 0x4DU, 0xE4U, 0x72U, 0xA6U,
-	0x06U, 0xBFU, 0x8BU, 0x62U, 0x66U, 0xDDU, 0x30U, 0xFDU, 0xE2U, 0x98U, 0x25U, 0xB3U, 0x10U, 0x91U, 0x22U, 0x88U,
-	0x36U, 0xD0U, 0x94U, 0xCEU, 0x8FU, 0x96U, 0xDBU, 0xBDU, 0xF1U, 0xD2U, 0x13U, 0x5CU, 0x83U, 0x38U, 0x46U, 0x40U,
-	0x1EU, 0x42U, 0xB6U, 0xA3U, 0xC3U, 0x48U, 0x7EU, 0x6EU, 0x6BU, 0x3AU, 0x28U, 0x54U, 0xFAU, 0x85U, 0xBAU, 0x3DU,
-	0xCAU, 0x5EU, 0x9BU, 0x9FU, 0x0AU, 0x15U, 0x79U, 0x2BU, 0x4EU, 0xD4U, 0xE5U, 0xACU, 0x73U, 0xF3U, 0xA7U, 0x57U,
-	0x07U, 0x70U, 0xC0U, 0xF7U, 0x8CU, 0x80U, 0x63U, 0x0DU, 0x67U, 0x4AU, 0xDEU, 0xEDU, 0x31U, 0xC5U, 0xFEU, 0x18U,
-	0xE3U, 0xA5U, 0x99U, 0x77U, 0x26U, 0xB8U, 0xB4U, 0x7CU, 0x11U, 0x44U, 0x92U, 0xD9U, 0x23U, 0x20U, 0x89U, 0x2EU,
-	0x37U, 0x3FU, 0xD1U, 0x5BU, 0x95U, 0xBCU, 0xCFU, 0xCDU, 0x90U, 0x87U, 0x97U, 0xB2U, 0xDCU, 0xFCU, 0xBEU, 0x61U,
-	0xF2U, 0x56U, 0xD3U, 0xABU, 0x14U, 0x2AU, 0x5DU, 0x9EU, 0x84U, 0x3CU, 0x39U, 0x53U, 0x47U, 0x6DU, 0x41U, 0xA2U,
-	0x1FU, 0x2DU, 0x43U, 0xD8U, 0xB7U, 0x7BU, 0xA4U, 0x76U, 0xC4U, 0x17U, 0x49U, 0xECU, 0x7FU, 0x0CU, 0x6FU, 0xF6U,
-	0x6CU, 0xA1U, 0x3BU, 0x52U, 0x29U, 0x9DU, 0x55U, 0xAAU, 0xFBU, 0x60U, 0x86U, 0xB1U, 0xBBU, 0xCCU, 0x3EU, 0x5AU,
-	0xCBU, 0x59U, 0x5FU, 0xB0U, 0x9CU, 0xA9U, 0xA0U, 0x51U, 0x0BU, 0xF5U, 0x16U, 0xEBU, 0x7AU, 0x75U, 0x2CU, 0xD7U,
-	0x4FU, 0xAEU, 0xD5U, 0xE9U, 0xE6U, 0xE7U, 0xADU, 0xE8U, 0x74U, 0xD6U, 0xF4U, 0xEAU, 0xA8U, 0x50U, 0x58U, 0xAFU};
-
-/* multiplication using logarithms */
-static unsigned char gmult(unsigned char a, unsigned char b)
+// The generator polynomial is x^3 + 14x^2 + 56x + 64 over GF(256). Entry n
+// holds n multiplied by 14, 56 and 64 in its top, middle and bottom bytes,
+// which is how a feedback byte of n changes the three parity bytes.
+const unsigned int PARITY_TABLE[] = {
+	0x000000U, 0x0E3840U, 0x1C7080U, 0x1248C0U, 0x38E01DU, 0x36D85DU, 0x24909DU, 0x2AA8DDU,
+	0x70DD3AU, 0x7EE57AU, 0x6CADBAU, 0x6295FAU, 0x483D27U, 0x460567U, 0x544DA7U, 0x5A75E7U,
+	0xE0A774U, 0xEE9F34U, 0xFCD7F4U, 0xF2EFB4U, 0xD84769U, 0xD67F29U, 0xC437E9U, 0xCA0FA9U,
+	0x907A4EU, 0x9E420EU, 0x8C0ACEU, 0x82328EU, 0xA89A53U, 0xA6A213U, 0xB4EAD3U, 0xBAD293U,
+	0xDD53E8U, 0xD36BA8U, 0xC12368U, 0xCF1B28U, 0xE5B3F5U, 0xEB8BB5U, 0xF9C375U, 0xF7FB35U,
+	0xAD8ED2U, 0xA3B692U, 0xB1FE52U, 0xBFC612U, 0x956ECFU, 0x9B568FU, 0x891E4FU, 0x87260FU,
+	0x3DF49CU, 0x33CCDCU, 0x21841CU, 0x2FBC5CU, 0x051481U, 0x0B2CC1U, 0x196401U, 0x175C41U,
+	0x4D29A6U, 0x4311E6U, 0x515926U, 0x5F6166U, 0x75C9BBU, 0x7BF1FBU, 0x69B93BU, 0x67817BU,
+	0xA7A6CDU, 0xA99E8DU, 0xBBD64DU, 0xB5EE0DU, 0x9F46D0U, 0x917E90U, 0x833650U, 0x8D0E10U,
+	0xD77BF7U, 0xD943B7U, 0xCB0B77U, 0xC53337U, 0xEF9BEAU, 0xE1A3AAU, 0xF3EB6AU, 0xFDD32AU,
+	0x4701B9U, 0x4939F9U, 0x5B7139U, 0x554979U, 0x7FE1A4U, 0x71D9E4U, 0x639124U, 0x6DA964U,
+	0x37DC83U, 0x39E4C3U, 0x2BAC03U, 0x259443U, 0x0F3C9EU, 0x0104DEU, 0x134C1EU, 0x1D745EU,
+	0x7AF525U, 0x74CD65U, 0x6685A5U, 0x68BDE5U, 0x421538U, 0x4C2D78U, 0x5E65B8U, 0x505DF8U,
+	0x0A281FU, 0x04105FU, 0x16589FU, 0x1860DFU, 0x32C802U, 0x3CF042U, 0x2EB882U, 0x2080C2U,
+	0x9A5251U, 0x946A11U, 0x8622D1U, 0x881A91U, 0xA2B24CU, 0xAC8A0CU, 0xBEC2CCU, 0xB0FA8CU,
+	0xEA8F6BU, 0xE4B72BU, 0xF6FFEBU, 0xF8C7ABU, 0xD26F76U, 0xDC5736U, 0xCE1FF6U, 0xC027B6U,
+	0x535187U, 0x5D69C7U, 0x4F2107U, 0x411947U, 0x6BB19AU, 0x6589DAU, 0x77C11AU, 0x79F95AU,
+	0x238CBDU, 0x2DB4FDU, 0x3FFC3DU, 0x31C47DU, 0x1B6CA0U, 0x1554E0U, 0x071C20U, 0x092460U,
+	0xB3F6F3U, 0xBDCEB3U, 0xAF8673U, 0xA1BE33U, 0x8B16EEU, 0x852EAEU, 0x97666EU, 0x995E2EU,
+	0xC32BC9U, 0xCD1389U, 0xDF5B49U, 0xD16309U, 0xFBCBD4U, 0xF5F394U, 0xE7BB54U, 0xE98314U,
+	0x8E026FU, 0x803A2FU, 0x9272EFU, 0x9C4AAFU, 0xB6E272U, 0xB8DA32U, 0xAA92F2U, 0xA4AAB2U,
+	0xFEDF55U, 0xF0E715U, 0xE2AFD5U, 0xEC9795U, 0xC63F48U, 0xC80708U, 0xDA4FC8U, 0xD47788U,
+	0x6EA51BU, 0x609D5BU, 0x72D59BU, 0x7CEDDBU, 0x564506U, 0x587D46U, 0x4A3586U, 0x440DC6U,
+	0x1E7821U, 0x104061U, 0x0208A1U, 0x0C30E1U, 0x26983CU, 0x28A07CU, 0x3AE8BCU, 0x34D0FCU,
+	0xF4F74AU, 0xFACF0AU, 0xE887CAU, 0xE6BF8AU, 0xCC1757U, 0xC22F17U, 0xD067D7U, 0xDE5F97U,
+	0x842A70U, 0x8A1230U, 0x985AF0U, 0x9662B0U, 0xBCCA6DU, 0xB2F22DU, 0xA0BAEDU, 0xAE82ADU,
+	0x14503EU, 0x1A687EU, 0x0820BEU, 0x0618FEU, 0x2CB023U, 0x228863U, 0x30C0A3U, 0x3EF8E3U,
+	0x648D04U, 0x6AB544U, 0x78FD84U, 0x76C5C4U, 0x5C6D19U, 0x525559U, 0x401D99U, 0x4E25D9U,
+	0x29A4A2U, 0x279CE2U, 0x35D422U, 0x3BEC62U, 0x1144BFU, 0x1F7CFFU, 0x0D343FU, 0x030C7FU,
+	0x597998U, 0x5741D8U, 0x450918U, 0x4B3158U, 0x619985U, 0x6FA1C5U, 0x7DE905U, 0x73D145U,
+	0xC903D6U, 0xC73B96U, 0xD57356U, 0xDB4B16U, 0xF1E3CBU, 0xFFDB8BU, 0xED934BU, 0xE3AB0BU,
+	0xB9DEECU, 0xB7E6ACU, 0xA5AE6CU, 0xAB962CU, 0x813EF1U, 0x8F06B1U, 0x9D4E71U, 0x937631U};
+
+// The effect of a message byte on the parity depends only on its distance from
+// the end of the message, so each byte can be looked up on its own rather than
+// clocking the LFSR. Entry [n][b] is the parity of the byte b followed by n
+// zero bytes. Row 0 is the table above, and the rest are derived from it when
+// the program starts.
+const unsigned int MAX_SLICES = 9U;
+
+static unsigned int PARITY_SLICES[MAX_SLICES][256U];
+
+static bool createSlices()
 {
-  if (a == 0U || b == 0U)
-	  return 0U;
+	for (unsigned int b = 0U; b < 256U; b++)
+		PARITY_SLICES[0U][b] = PARITY_TABLE[b];
 
-  unsigned int i = LOG_TABLE[a];
-  unsigned int j = LOG_TABLE[b];
+	for (unsigned int n = 1U; n < MAX_SLICES; n++) {
+		for (unsigned int b = 0U; b < 256U; b++) {
+			unsigned int parity = PARITY_SLICES[n - 1U][b];
+			PARITY_SLICES[n][b] = ((parity << 8) & 0xFFFF00U) ^ PARITY_TABLE[parity >> 16];
+		}
+	}
 
-  return EXP_TABLE[i + j];
+	return true;
 }
 
+static const bool SLICES_CREATED = createSlices();
+
 /* Simulate a LFSR with generator polynomial for n byte RS code. 
  * Pass in a pointer to the data array, and amount of data. 
  *
- * The parity bytes are deposited into parity.
+ * The parity bytes are returned with parity[0] in the bottom byte.
  */
-void CRS129::encode(const unsigned char* msg, unsigned int nbytes, unsigned char* parity)
+static unsigned int lfsr(const unsigned char* msg, unsigned int nbytes)
 {
-  assert(msg != NULL);
-  assert(parity != NULL);
+  unsigned int parity = 0U;
 
-  for (unsigned int i = 0U; i < NPAR + 1U; i++)
-	  parity[i] = 0x00U;
+  if (nbytes <= MAX_SLICES) {
+    for (unsigned int i = 0U; i < nbytes; i++)
+      parity ^= PARITY_SLICES[nbytes - 1U - i][msg[i]];
 
-  for (unsigned int i = 0U; i < nbytes; i++) {
-    unsigned char dbyte = msg[i] ^ parity[NPAR - 1U];
+    return parity;
+  }
 
-	for (int j = NPAR - 1; j > 0; j--)
-		parity[j] = parity[j - 1] ^ ::gmult(POLY[j], dbyte);
+  for (unsigned int i = 0U; i < nbytes; i++) {
+    unsigned char dbyte = msg[i] ^ (parity >> 16);
 
-	parity[0] = ::gmult(POLY[0], dbyte);
+    parity = ((parity << 8) & 0xFFFF00U) ^ PARITY_TABLE[dbyte];
   }
+
+  return parity;
+}
+
+void CRS129::encode(const unsigned char* msg, unsigned int nbytes, unsigned char* parity)
+{
+  assert(msg != NULL);
+  assert(parity != NULL);
+
+  unsigned int lfsr = ::lfsr(msg, nbytes);
+
+  parity[0U] = lfsr >> 0;
+  parity[1U] = lfsr >> 8;
+  parity[2U] = lfsr >> 16;
+  parity[NPAR] = 0x00U;
 }
 
 // Reed-Solomon (12,9) check
@@ -122,9 +129,8 @@ bool CRS129::check(const unsigned char* in)
 {
 	assert(in != NULL);
 
-	unsigned char parity[4U];
-	encode(in, 9U, parity);
+	unsigned int parity = (in[9U] << 16) | (in[10U] << 8) | in[11U];
 
-	return in[9U] == parity[2U] && in[10U] == parity[1U] && in[11U] == parity[0U];
+	return ::lfsr(in, 9U) == parity;
 }
 
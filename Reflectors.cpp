@@ -95,6 +95,11 @@ CReflector* CReflectors::find(unsigned int id)
 	return NULL;
 }
 
+unsigned int CReflectors::getDeadline(unsigned int ms)
+{
+	return m_timer.getDeadline(ms);
+}
+
 void CReflectors::clock(unsigned int ms)
 {
     m_timer.clock(ms);
@@ -49,6 +49,8 @@ public:
 
     void clock(unsigned int ms);
 
+	unsigned int getDeadline(unsigned int ms);
+
 private:
 	std::string              m_hostsFile;
 	std::vector<CReflector*> m_reflectors;
@@ -23,6 +23,8 @@
 
 #include <string>
 
+class CPoller;
+
 class IRepeaterProtocol {
 public:
 	virtual ~IRepeaterProtocol() = 0;
@@ -35,6 +37,8 @@ public:
 
 	virtual bool open() = 0;
 
+	virtual bool startThread(CPoller* poller) = 0;
+
 	virtual bool read(CDMRData& data) = 0;
 
 	virtual bool write(const CDMRData& data) = 0;
@@ -47,6 +51,12 @@ public:
 
 	virtual void clock(unsigned int ms) = 0;
 
+	virtual void flush() = 0;
+
+	virtual unsigned int getDeadline(unsigned int ms) = 0;
+
+	virtual int  getFd() const = 0;
+
 	virtual bool writeBeacon() = 0;
 
 	virtual void close() = 0;
@@ -0,0 +1,166 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Resolver.h"
+#include "Log.h"
+
+#include <cassert>
+
+CResolver::CResolver(unsigned int refresh, unsigned int retry) :
+m_refresh(refresh),
+m_retry(retry),
+m_entries(),
+m_mutex(),
+m_cond(),
+m_stop(false),
+m_started(false)
+{
+	assert(refresh > 0U);
+	assert(retry > 0U);
+}
+
+CResolver::~CResolver()
+{
+}
+
+bool CResolver::start()
+{
+	bool ret = run();
+	if (!ret) {
+		LogError("Unable to start the resolver thread");
+		return false;
+	}
+
+	m_started = true;
+
+	return true;
+}
+
+bool CResolver::lookup(const std::string& hostName, CUDPAddress& address)
+{
+	assert(!hostName.empty());
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::map<std::string, CResolverEntry>::iterator it = m_entries.find(hostName);
+	if (it == m_entries.end()) {
+		CResolverEntry entry;
+		entry.m_valid   = false;
+		entry.m_used    = true;
+		entry.m_expires = CClock::now();
+
+		m_entries.insert(std::make_pair(hostName, entry));
+		m_cond.notify_one();
+
+		return false;
+	}
+
+	CResolverEntry& entry = it->second;
+	entry.m_used = true;
+
+	if (!entry.m_valid)
+		return false;
+
+	address = entry.m_address;
+
+	return true;
+}
+
+void CResolver::stop()
+{
+	if (!m_started)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		m_cond.notify_one();
+	}
+
+	wait();
+
+	m_started = false;
+}
+
+void CResolver::entry()
+{
+	LogMessage("Started the resolver thread");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (!m_stop) {
+		CClock::time_point now = CClock::now();
+
+		// Find the first entry that is due, and when the next one is due after that
+		std::map<std::string, CResolverEntry>::iterator due = m_entries.end();
+		CClock::time_point next = now + std::chrono::seconds(m_refresh);
+
+		for (std::map<std::string, CResolverEntry>::iterator it = m_entries.begin(); it != m_entries.end();) {
+			CResolverEntry& entry = it->second;
+			if (entry.m_expires <= now) {
+				if (!entry.m_used) {
+					LogDebug("Resolver, forgetting %s", it->first.c_str());
+					m_entries.erase(it++);
+					continue;
+				}
+
+				if (due == m_entries.end())
+					due = it;
+			} else if (entry.m_expires < next) {
+				next = entry.m_expires;
+			}
+
+			++it;
+		}
+
+		if (due == m_entries.end()) {
+			m_cond.wait_until(lock, next);
+			continue;
+		}
+
+		std::string hostName = due->first;
+
+		// The lookup may take many seconds, so don't hold up lookup() meanwhile
+		lock.unlock();
+
+		CUDPAddress address;
+		bool ret = CUDPSocket::lookup(hostName, 0U, address);
+
+		lock.lock();
+
+		// The entry can only be removed by this thread, so it's still there
+		CResolverEntry& entry = m_entries[hostName];
+		entry.m_used = false;
+
+		if (ret) {
+			if (!entry.m_valid || entry.m_address != address)
+				LogMessage("Resolver, %s is at %s", hostName.c_str(), address.getHost().c_str());
+
+			entry.m_address = address;
+			entry.m_valid   = true;
+			entry.m_expires = CClock::now() + std::chrono::seconds(m_refresh);
+		} else {
+			// Keep any previous address, the name server may only be unreachable for now
+			LogWarning("Resolver, cannot find the address of %s%s", hostName.c_str(), entry.m_valid ? ", keeping the old one" : "");
+			entry.m_expires = CClock::now() + std::chrono::seconds(m_retry);
+		}
+	}
+
+	LogMessage("Stopped the resolver thread");
+}
@@ -0,0 +1,73 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(Resolver_H)
+#define	Resolver_H
+
+#include "UDPSocket.h"
+#include "Thread.h"
+
+#include <condition_variable>
+#include <chrono>
+#include <string>
+#include <mutex>
+#include <map>
+
+// Looks up host names on its own thread so that a slow name server never
+// holds up the main loop. lookup() only ever consults the cache, a host name
+// that isn't there yet is queued and the caller asks again later. Addresses
+// are looked up again every refresh period in the background, and a host
+// name that can't be found isn't tried again until the retry period is up.
+// Host names that nobody has asked for over a whole refresh period are
+// forgotten.
+class CResolver : public CThread
+{
+public:
+	CResolver(unsigned int refresh, unsigned int retry);
+	virtual ~CResolver();
+
+	bool start();
+
+	// The address comes back with no port
+	bool lookup(const std::string& hostName, CUDPAddress& address);
+
+	void stop();
+
+	virtual void entry();
+
+private:
+	typedef std::chrono::steady_clock CClock;
+
+	struct CResolverEntry {
+		bool               m_valid;
+		bool               m_used;
+		CClock::time_point m_expires;
+		CUDPAddress        m_address;
+	};
+
+	unsigned int                          m_refresh;
+	unsigned int                          m_retry;
+	std::map<std::string, CResolverEntry> m_entries;
+	std::mutex                            m_mutex;
+	std::condition_variable               m_cond;
+	bool                                  m_stop;
+	bool                                  m_started;
+};
+
+#endif
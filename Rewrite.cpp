@@ -24,6 +24,9 @@
 
 #include <cstdio>
 
+unsigned int CRewrite::m_rewritten = 0U;
+unsigned int CRewrite::m_unchanged = 0U;
+
 CRewrite::CRewrite() :
 m_lc(),
 m_embeddedLC(),
@@ -206,13 +209,25 @@ void CRewrite::processDataHeader(CDMRData& data)
 	if (!ret)
 		return;
 
-	dataHeader.setGI(data.getFLCO() == FLCO_GROUP);
-	dataHeader.setSrcId(data.getSrcId());
-	dataHeader.setDstId(data.getDstId());
+	bool group = data.getFLCO() == FLCO_GROUP;
+	unsigned int srcId = data.getSrcId();
+	unsigned int dstId = data.getDstId();
+
+	// Save re-encoding it when the header already has the new ids
+	if (dataHeader.getGI() == group && dataHeader.getSrcId() == srcId && dataHeader.getDstId() == dstId) {
+		m_unchanged++;
+		return;
+	}
+
+	dataHeader.setGI(group);
+	dataHeader.setSrcId(srcId);
+	dataHeader.setDstId(dstId);
 
 	dataHeader.get(buffer);
 
 	data.setData(buffer);
+
+	m_rewritten++;
 }
 
 void CRewrite::processData(CDMRData& data)
@@ -230,11 +245,35 @@ void CRewrite::processCSBK(CDMRData& data)
 	if (!ret)
 		return;
 
-	csbk.setGI(data.getFLCO() == FLCO_GROUP);
-	csbk.setSrcId(data.getSrcId());
-	csbk.setDstId(data.getDstId());
+	bool group = data.getFLCO() == FLCO_GROUP;
+	unsigned int srcId = data.getSrcId();
+	unsigned int dstId = data.getDstId();
+
+	// Only a preamble CSBK carries the group flag, so save re-encoding the others
+	// when their ids are already the new ones
+	bool sameGI = csbk.getCSBKO() != CSBKO_PRECCSBK || csbk.getGI() == group;
+	if (sameGI && csbk.getSrcId() == srcId && csbk.getDstId() == dstId) {
+		m_unchanged++;
+		return;
+	}
+
+	csbk.setGI(group);
+	csbk.setSrcId(srcId);
+	csbk.setDstId(dstId);
 
 	csbk.get(buffer);
 
 	data.setData(buffer);
+
+	m_rewritten++;
+}
+
+unsigned int CRewrite::getRewritten()
+{
+	return m_rewritten;
+}
+
+unsigned int CRewrite::getUnchanged()
+{
+	return m_unchanged;
 }
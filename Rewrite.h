@@ -23,6 +23,15 @@
 #include "DMRData.h"
 #include "DMRLC.h"
 
+// The frames that a rule applies to, used to build the routing tables
+struct CRewriteMatch {
+	unsigned int m_slot;
+	FLCO         m_flco;
+	bool         m_srcId;
+	unsigned int m_idStart;
+	unsigned int m_idEnd;
+};
+
 class CRewrite {
 public:
 	CRewrite();
@@ -30,6 +39,13 @@ public:
 
 	virtual bool process(CDMRData& data, bool trace) = 0;
 
+	virtual CRewriteMatch getMatch() const = 0;
+
+	// The CSBKs and data headers that were re-encoded with new ids, and those that
+	// already carried them and were passed on untouched
+	static unsigned int getRewritten();
+	static unsigned int getUnchanged();
+
 protected:
 	void processMessage(CDMRData& data);
 
@@ -41,6 +57,9 @@ private:
 	unsigned int      m_readNum;
 	unsigned char     m_lastN;
 
+	static unsigned int m_rewritten;
+	static unsigned int m_unchanged;
+
 	void processHeader(CDMRData& data, unsigned char dataType);
 	void processVoiceSync(CDMRData& data);
 	void processVoice(CDMRData& data);
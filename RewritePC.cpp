@@ -72,3 +72,15 @@ bool CRewritePC::process(CDMRData& data, bool trace)
 
 	return true;
 }
+
+CRewriteMatch CRewritePC::getMatch() const
+{
+	CRewriteMatch match;
+	match.m_slot    = m_fromSlot;
+	match.m_flco    = FLCO_USER_USER;
+	match.m_srcId   = false;
+	match.m_idStart = m_fromIdStart;
+	match.m_idEnd   = m_fromIdEnd;
+
+	return match;
+}
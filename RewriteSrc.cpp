@@ -69,3 +69,15 @@ bool CRewriteSrc::process(CDMRData& data, bool trace)
 
 	return true;
 }
+
+CRewriteMatch CRewriteSrc::getMatch() const
+{
+	CRewriteMatch match;
+	match.m_slot    = m_fromSlot;
+	match.m_flco    = FLCO_USER_USER;
+	match.m_srcId   = true;
+	match.m_idStart = m_fromIdStart;
+	match.m_idEnd   = m_fromIdEnd;
+
+	return match;
+}
@@ -83,3 +83,15 @@ bool CRewriteTG::process(CDMRData& data, bool trace)
 
 	return true;
 }
+
+CRewriteMatch CRewriteTG::getMatch() const
+{
+	CRewriteMatch match;
+	match.m_slot    = m_fromSlot;
+	match.m_flco    = FLCO_GROUP;
+	match.m_srcId   = false;
+	match.m_idStart = m_fromTGStart;
+	match.m_idEnd   = m_fromTGEnd;
+
+	return match;
+}
@@ -66,3 +66,15 @@ bool CRewriteType::process(CDMRData& data, bool trace)
 
 	return true;
 }
+
+CRewriteMatch CRewriteType::getMatch() const
+{
+	CRewriteMatch match;
+	match.m_slot    = m_fromSlot;
+	match.m_flco    = FLCO_GROUP;
+	match.m_srcId   = false;
+	match.m_idStart = m_fromTG;
+	match.m_idEnd   = m_fromTG;
+
+	return match;
+}
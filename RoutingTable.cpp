@@ -0,0 +1,233 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RoutingTable.h"
+#include "DMRDefines.h"
+
+#include <algorithm>
+#include <utility>
+#include <cassert>
+#include <cstdint>
+#include <set>
+
+const unsigned int NO_RULE = 0xFFFFFFFFU;
+
+const unsigned int STREAM_TIMEOUT = 1000U;
+
+// The ranges are held separately for each slot, FLCO and id type
+static unsigned int getIndex(unsigned int slotNo, FLCO flco, bool srcId)
+{
+	return (slotNo - 1U) * 4U + (flco == FLCO_GROUP ? 0U : 2U) + (srcId ? 1U : 0U);
+}
+
+CRoutingTable::CRoutingTable() :
+m_rules(),
+m_ranges(),
+m_streams()
+{
+}
+
+CRoutingTable::~CRoutingTable()
+{
+}
+
+void CRoutingTable::add(CRewrite* rewrite, unsigned int network)
+{
+	assert(rewrite != NULL);
+	assert(network > 0U);
+
+	CRoutingRule rule;
+	rule.m_rewrite = rewrite;
+	rule.m_network = network;
+
+	m_rules.push_back(rule);
+}
+
+void CRoutingTable::compile()
+{
+	for (unsigned int i = 0U; i < 8U; i++) {
+		// Each rule adds its number at the start of its range and removes it
+		// again after the end, 64-bit so that a range may end at 0xFFFFFFFF
+		std::vector<std::pair<uint64_t, unsigned int> > starts;
+		std::vector<std::pair<uint64_t, unsigned int> > ends;
+
+		for (unsigned int n = 0U; n < m_rules.size(); n++) {
+			CRewriteMatch match = m_rules[n].m_rewrite->getMatch();
+			if (match.m_slot != 1U && match.m_slot != 2U)
+				continue;
+			if (match.m_flco != FLCO_GROUP && match.m_flco != FLCO_USER_USER)
+				continue;
+			if (getIndex(match.m_slot, match.m_flco, match.m_srcId) != i)
+				continue;
+			if (match.m_idEnd < match.m_idStart)
+				continue;
+
+			starts.push_back(std::make_pair(uint64_t(match.m_idStart), n));
+			ends.push_back(std::make_pair(uint64_t(match.m_idEnd) + 1U, n));
+		}
+
+		std::sort(starts.begin(), starts.end());
+		std::sort(ends.begin(), ends.end());
+
+		std::vector<CRoutingRange>& ranges = m_ranges[i];
+		ranges.clear();
+
+		// Sweep along the ids, the lowest numbered active rule is the one that
+		// would have matched first
+		std::set<unsigned int> active;
+		unsigned int s = 0U;
+		unsigned int e = 0U;
+		while (s < starts.size() || e < ends.size()) {
+			uint64_t id = e < ends.size() ? ends[e].first : 0x100000000ULL;
+			if (s < starts.size() && starts[s].first < id)
+				id = starts[s].first;
+
+			if (id > 0xFFFFFFFFULL)
+				break;
+
+			while (e < ends.size() && ends[e].first == id)
+				active.erase(ends[e++].second);
+			while (s < starts.size() && starts[s].first == id)
+				active.insert(starts[s++].second);
+
+			unsigned int rule = active.empty() ? NO_RULE : *active.begin();
+
+			if (ranges.empty() && rule == NO_RULE)
+				continue;
+			if (!ranges.empty() && ranges.back().m_rule == rule)
+				continue;
+
+			CRoutingRange range;
+			range.m_idStart = (unsigned int)id;
+			range.m_rule    = rule;
+			ranges.push_back(range);
+		}
+	}
+
+	for (unsigned int i = 0U; i < 2U; i++)
+		m_streams[i].m_valid = false;
+}
+
+unsigned int CRoutingTable::process(CDMRData& data, bool trace)
+{
+	// Tracing needs every rule to report whether it matched, so do it the slow way
+	if (trace) {
+		for (std::vector<CRoutingRule>::const_iterator it = m_rules.begin(); it != m_rules.end(); ++it) {
+			bool ret = (*it).m_rewrite->process(data, true);
+			if (ret)
+				return (*it).m_network;
+		}
+
+		return 0U;
+	}
+
+	unsigned int slotNo = data.getSlotNo();
+	if (slotNo != 1U && slotNo != 2U)
+		return 0U;
+
+	unsigned int streamId = data.getStreamId();
+	FLCO flco             = data.getFLCO();
+	unsigned int srcId    = data.getSrcId();
+	unsigned int dstId    = data.getDstId();
+
+	// The addressing cannot change within a stream, but check it anyway
+	CRoutingStream& stream = m_streams[slotNo - 1U];
+	if (!stream.m_valid || stream.m_streamId != streamId || stream.m_flco != flco || stream.m_srcId != srcId || stream.m_dstId != dstId) {
+		stream.m_valid    = true;
+		stream.m_streamId = streamId;
+		stream.m_flco     = flco;
+		stream.m_srcId    = srcId;
+		stream.m_dstId    = dstId;
+		stream.m_rule     = find(data);
+	}
+
+	stream.m_idle = 0U;
+
+	unsigned int rule = stream.m_rule;
+
+	if (data.getDataType() == DT_TERMINATOR_WITH_LC)
+		stream.m_valid = false;
+
+	if (rule == NO_RULE)
+		return 0U;
+
+	// The rule is known to match, so this just does the rewriting
+	m_rules[rule].m_rewrite->process(data, false);
+
+	return m_rules[rule].m_network;
+}
+
+void CRoutingTable::clock(unsigned int ms)
+{
+	for (unsigned int i = 0U; i < 2U; i++) {
+		if (!m_streams[i].m_valid)
+			continue;
+
+		m_streams[i].m_idle += ms;
+		if (m_streams[i].m_idle >= STREAM_TIMEOUT)
+			m_streams[i].m_valid = false;
+	}
+}
+
+unsigned int CRoutingTable::getRules() const
+{
+	return (unsigned int)m_rules.size();
+}
+
+unsigned int CRoutingTable::getRanges() const
+{
+	unsigned int count = 0U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		count += (unsigned int)m_ranges[i].size();
+
+	return count;
+}
+
+unsigned int CRoutingTable::find(const CDMRData& data) const
+{
+	unsigned int slotNo = data.getSlotNo();
+	FLCO flco = data.getFLCO();
+
+	if (flco != FLCO_GROUP && flco != FLCO_USER_USER)
+		return NO_RULE;
+
+	unsigned int dstRule = find(m_ranges[getIndex(slotNo, flco, false)], data.getDstId());
+	unsigned int srcRule = find(m_ranges[getIndex(slotNo, flco, true)],  data.getSrcId());
+
+	return std::min(dstRule, srcRule);
+}
+
+unsigned int CRoutingTable::find(const std::vector<CRoutingRange>& ranges, unsigned int id) const
+{
+	if (ranges.empty() || id < ranges.front().m_idStart)
+		return NO_RULE;
+
+	// Find the last range that starts at or before the id
+	unsigned int lo = 0U;
+	unsigned int hi = (unsigned int)ranges.size();
+	while (hi - lo > 1U) {
+		unsigned int mid = (lo + hi) / 2U;
+		if (ranges[mid].m_idStart <= id)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return ranges[lo].m_rule;
+}
@@ -0,0 +1,83 @@
+/*
+ *   Copyright (C) 2018 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(RoutingTable_H)
+#define	RoutingTable_H
+
+#include "Rewrite.h"
+#include "DMRData.h"
+
+#include <vector>
+
+// Holds an ordered list of rewrite rules and compiles them into sorted
+// tables of id ranges, so that the first rule to match a frame can be found
+// with a binary search rather than by trying every rule in turn. The result
+// is remembered for the current stream on each slot, so the rest of a
+// transmission goes straight to the same rule.
+class CRoutingTable {
+public:
+	CRoutingTable();
+	~CRoutingTable();
+
+	// Rules are tried in the order that they are added, the network is
+	// returned by process() when the rule matches
+	void add(CRewrite* rewrite, unsigned int network);
+
+	void compile();
+
+	// Rewrites the frame with the first matching rule and returns its
+	// network, or 0U if nothing matched
+	unsigned int process(CDMRData& data, bool trace);
+
+	// Forgets streams that have gone quiet without a terminator
+	void clock(unsigned int ms);
+
+	unsigned int getRules() const;
+	unsigned int getRanges() const;
+
+private:
+	struct CRoutingRule {
+		CRewrite*    m_rewrite;
+		unsigned int m_network;
+	};
+
+	struct CRoutingRange {
+		unsigned int m_idStart;
+		unsigned int m_rule;
+	};
+
+	struct CRoutingStream {
+		bool         m_valid;
+		unsigned int m_streamId;
+		FLCO         m_flco;
+		unsigned int m_srcId;
+		unsigned int m_dstId;
+		unsigned int m_rule;
+		unsigned int m_idle;
+	};
+
+	std::vector<CRoutingRule>  m_rules;
+	std::vector<CRoutingRange> m_ranges[8U];
+	CRoutingStream             m_streams[2U];
+
+	unsigned int find(const std::vector<CRoutingRange>& ranges, unsigned int id) const;
+	unsigned int find(const CDMRData& data) const;
+};
+
+#endif
@@ -46,23 +46,16 @@ static const unsigned char fillbuf[64] = { 0x80, 0 /* , 0, 0, ...  */ };
   must be called before using hash in the call to sha256_hash
 */
 CSHA256::CSHA256() :
-m_state(NULL),
-m_total(NULL),
+m_state(),
+m_total(),
 m_buflen(0U),
-m_buffer(NULL)
+m_buffer()
 {
-	m_state  = new uint32_t[8U];
-	m_total  = new uint32_t[2U];
-	m_buffer = new uint32_t[32U];
-
 	init();
 }
 
 CSHA256::~CSHA256()
 {
-	delete[] m_state;
-	delete[] m_total;
-	delete[] m_buffer;
 }
 
 void CSHA256::init()
@@ -155,6 +148,20 @@ unsigned char* CSHA256::buffer(const unsigned char* buffer, unsigned int len, un
 	return finish(resblock);
 }
 
+unsigned char* CSHA256::buffer(const unsigned char* buffer1, unsigned int len1, const unsigned char* buffer2, unsigned int len2, unsigned char* resblock)
+{
+	assert(buffer1 != NULL);
+	assert(buffer2 != NULL);
+	assert(resblock != NULL);
+
+	init();
+
+	processBytes(buffer1, len1);
+	processBytes(buffer2, len2);
+
+	return finish(resblock);
+}
+
 void CSHA256::processBytes(const unsigned char* buffer, unsigned int len)
 {
 	assert(buffer != NULL);
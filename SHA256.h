@@ -60,11 +60,15 @@ public:
 	   digest.  */
 	unsigned char* buffer(const unsigned char* buffer, unsigned int len, unsigned char* resblock);
 
+	/* As above, but for the LEN1 bytes at BUFFER1 followed by the LEN2 bytes
+	   at BUFFER2, without having to join them first.  */
+	unsigned char* buffer(const unsigned char* buffer1, unsigned int len1, const unsigned char* buffer2, unsigned int len2, unsigned char* resblock);
+
 private:
-	uint32_t*    m_state;
-	uint32_t*    m_total;
+	uint32_t     m_state[8U];
+	uint32_t     m_total[2U];
 	unsigned int m_buflen;
-	uint32_t*    m_buffer;
+	uint32_t     m_buffer[32U];
 
 	void init();
 	void conclude();
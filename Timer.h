@@ -74,6 +74,17 @@ public:
 		return false;
 	}
 
+	// The number of ticks until the timer expires, limited to the value given
+	unsigned int getDeadline(unsigned int ticks)
+	{
+		if (m_timeout == 0U || m_timer == 0U || m_timer >= m_timeout)
+			return ticks;
+
+		unsigned int remaining = m_timeout - m_timer;
+
+		return remaining < ticks ? remaining : ticks;
+	}
+
 	void clock(unsigned int ticks = 1U)
 	{
 		if (m_timer > 0U && m_timeout > 0U)
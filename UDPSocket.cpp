@@ -26,11 +26,16 @@
 #include <cstring>
 #endif
 
+#if defined(__linux__)
+// The number of datagrams handed to the kernel in one recvmmsg()/sendmmsg() call
+const unsigned int MAX_BATCH = 32U;
+#endif
 
 CUDPSocket::CUDPSocket(const std::string& address, unsigned int port) :
 m_address(address),
 m_port(port),
-m_fd(-1)
+m_fd(-1),
+m_family(AF_INET)
 {
 	assert(!address.empty());
 
@@ -45,7 +50,8 @@ m_fd(-1)
 CUDPSocket::CUDPSocket(unsigned int port) :
 m_address(),
 m_port(port),
-m_fd(-1)
+m_fd(-1),
+m_family(AF_INET)
 {
 #if defined(_WIN32) || defined(_WIN64)
 	WSAData data;
@@ -62,49 +68,156 @@ CUDPSocket::~CUDPSocket()
 #endif
 }
 
-in_addr CUDPSocket::lookup(const std::string& hostname)
+void CUDPAddress::setPort(unsigned int port)
 {
-	in_addr addr;
-#if defined(_WIN32) || defined(_WIN64)
-	unsigned long address = ::inet_addr(hostname.c_str());
-	if (address != INADDR_NONE && address != INADDR_ANY) {
-		addr.s_addr = address;
-		return addr;
-	}
+	if (m_addr.ss_family == AF_INET)
+		((sockaddr_in&)m_addr).sin_port = htons(port);
+	else if (m_addr.ss_family == AF_INET6)
+		((sockaddr_in6&)m_addr).sin6_port = htons(port);
+}
 
-	struct hostent* hp = ::gethostbyname(hostname.c_str());
-	if (hp != NULL) {
-		::memcpy(&addr, hp->h_addr_list[0], sizeof(struct in_addr));
-		return addr;
-	}
+unsigned int CUDPAddress::getPort() const
+{
+	if (m_addr.ss_family == AF_INET)
+		return ntohs(((const sockaddr_in&)m_addr).sin_port);
+	else if (m_addr.ss_family == AF_INET6)
+		return ntohs(((const sockaddr_in6&)m_addr).sin6_port);
+	else
+		return 0U;
+}
 
-	LogError("Cannot find address for host %s", hostname.c_str());
+int CUDPAddress::getFamily() const
+{
+	return m_addr.ss_family;
+}
 
-	addr.s_addr = INADDR_NONE;
-	return addr;
-#else
-	in_addr_t address = ::inet_addr(hostname.c_str());
-	if (address != in_addr_t(-1)) {
-		addr.s_addr = address;
-		return addr;
-	}
+bool CUDPAddress::isSet() const
+{
+	return m_length > 0U;
+}
 
-	struct hostent* hp = ::gethostbyname(hostname.c_str());
-	if (hp != NULL) {
-		::memcpy(&addr, hp->h_addr_list[0], sizeof(struct in_addr));
-		return addr;
+std::string CUDPAddress::getHost() const
+{
+	if (m_length == 0U)
+		return "none";
+
+	char host[NI_MAXHOST];
+	if (::getnameinfo((const sockaddr*)&m_addr, m_length, host, NI_MAXHOST, NULL, 0, NI_NUMERICHOST) != 0)
+		return "unknown";
+
+	return host;
+}
+
+bool CUDPSocket::lookup(const std::string& hostName, unsigned int port, CUDPAddress& address, bool numeric)
+{
+	// Allow IPv6 literals to be written as [2001:db8::1]
+	std::string host = hostName;
+	if (host.size() > 2U && host[0U] == '[' && host[host.size() - 1U] == ']')
+		host = host.substr(1U, host.size() - 2U);
+
+	addrinfo hints;
+	::memset(&hints, 0x00, sizeof(addrinfo));
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = SOCK_DGRAM;
+	if (numeric)
+		hints.ai_flags = AI_NUMERICHOST;
+
+	addrinfo* res = NULL;
+	int err = ::getaddrinfo(host.c_str(), NULL, &hints, &res);
+	if (err != 0 || res == NULL)
+		return false;
+
+	address = CUDPAddress();
+	::memcpy(&address.m_addr, res->ai_addr, res->ai_addrlen);
+	address.m_length = res->ai_addrlen;
+	address.setPort(port);
+
+	::freeaddrinfo(res);
+
+	return true;
+}
+
+const sockaddr* CUDPSocket::toSocket(const CUDPAddress& address, sockaddr_in6& mapped, unsigned int& length) const
+{
+	if (m_family != AF_INET6 || address.m_addr.ss_family != AF_INET) {
+		length = address.m_length;
+		return (const sockaddr*)&address.m_addr;
 	}
 
-	LogError("Cannot find address for host %s", hostname.c_str());
+	// An IPv4 address sent from a dual stack socket has to be written as ::ffff:a.b.c.d
+	const sockaddr_in& in = (const sockaddr_in&)address.m_addr;
 
-	addr.s_addr = INADDR_NONE;
-	return addr;
-#endif
+	::memset(&mapped, 0x00, sizeof(sockaddr_in6));
+	mapped.sin6_family = AF_INET6;
+	mapped.sin6_port   = in.sin_port;
+	mapped.sin6_addr.s6_addr[10U] = 0xFFU;
+	mapped.sin6_addr.s6_addr[11U] = 0xFFU;
+	::memcpy(mapped.sin6_addr.s6_addr + 12U, &in.sin_addr, sizeof(in_addr));
+
+	length = sizeof(sockaddr_in6);
+	return (const sockaddr*)&mapped;
 }
 
-bool CUDPSocket::open()
+void CUDPSocket::fromSocket(CUDPAddress& address)
 {
-	m_fd = ::socket(PF_INET, SOCK_DGRAM, 0);
+	if (address.m_addr.ss_family != AF_INET6)
+		return;
+
+	const sockaddr_in6& in6 = (const sockaddr_in6&)address.m_addr;
+	if (!IN6_IS_ADDR_V4MAPPED(&in6.sin6_addr))
+		return;
+
+	// Turn ::ffff:a.b.c.d back into plain IPv4 so that it compares equal to the far end
+	sockaddr_in in;
+	::memset(&in, 0x00, sizeof(sockaddr_in));
+	in.sin_family = AF_INET;
+	in.sin_port   = in6.sin6_port;
+	::memcpy(&in.sin_addr, in6.sin6_addr.s6_addr + 12U, sizeof(in_addr));
+
+	::memset(&address.m_addr, 0x00, sizeof(sockaddr_storage));
+	::memcpy(&address.m_addr, &in, sizeof(sockaddr_in));
+	address.m_length = sizeof(sockaddr_in);
+}
+
+bool CUDPSocket::open(int family)
+{
+	CUDPAddress local;
+	if (m_port > 0U && !m_address.empty()) {
+		bool ret = lookup(m_address, m_port, local, true);
+		if (!ret) {
+			LogError("The local address is invalid - %s", m_address.c_str());
+			return false;
+		}
+
+		family = local.getFamily();
+	}
+
+	m_fd = -1;
+
+	if (family != AF_INET) {
+		m_fd = ::socket(PF_INET6, SOCK_DGRAM, 0);
+		if (m_fd >= 0) {
+			m_family = AF_INET6;
+
+			int v6only = 0;
+			if (::setsockopt(m_fd, IPPROTO_IPV6, IPV6_V6ONLY, (char *)&v6only, sizeof(v6only)) == -1) {
+#if defined(_WIN32) || defined(_WIN64)
+				LogWarning("Cannot make the UDP socket dual stack, err: %lu", ::GetLastError());
+#else
+				LogWarning("Cannot make the UDP socket dual stack, err: %d", errno);
+#endif
+			}
+		} else if (family == AF_INET6) {
+			LogError("Cannot create an IPv6 UDP socket, is IPv6 enabled?");
+			return false;
+		}
+	}
+
+	if (m_fd < 0) {
+		m_fd = ::socket(PF_INET, SOCK_DGRAM, 0);
+		m_family = AF_INET;
+	}
+
 	if (m_fd < 0) {
 #if defined(_WIN32) || defined(_WIN64)
 		LogError("Cannot create the UDP socket, err: %lu", ::GetLastError());
@@ -115,21 +228,19 @@ bool CUDPSocket::open()
 	}
 
 	if (m_port > 0U) {
-		sockaddr_in addr;
-		::memset(&addr, 0x00, sizeof(sockaddr_in));
-		addr.sin_family      = AF_INET;
-		addr.sin_port        = htons(m_port);
-		addr.sin_addr.s_addr = htonl(INADDR_ANY);
-
-		if (!m_address.empty()) {
-#if defined(_WIN32) || defined(_WIN64)
-			addr.sin_addr.s_addr = ::inet_addr(m_address.c_str());
-#else
-			addr.sin_addr.s_addr = ::inet_addr(m_address.c_str());
-#endif
-			if (addr.sin_addr.s_addr == INADDR_NONE) {
-				LogError("The local address is invalid - %s", m_address.c_str());
-				return false;
+		if (!local.isSet()) {
+			if (m_family == AF_INET6) {
+				sockaddr_in6& addr = (sockaddr_in6&)local.m_addr;
+				addr.sin6_family = AF_INET6;
+				addr.sin6_port   = htons(m_port);
+				addr.sin6_addr   = in6addr_any;
+				local.m_length   = sizeof(sockaddr_in6);
+			} else {
+				sockaddr_in& addr = (sockaddr_in&)local.m_addr;
+				addr.sin_family      = AF_INET;
+				addr.sin_port        = htons(m_port);
+				addr.sin_addr.s_addr = htonl(INADDR_ANY);
+				local.m_length       = sizeof(sockaddr_in);
 			}
 		}
 
@@ -143,7 +254,7 @@ bool CUDPSocket::open()
 			return false;
 		}
 
-		if (::bind(m_fd, (sockaddr*)&addr, sizeof(sockaddr_in)) == -1) {
+		if (::bind(m_fd, (sockaddr*)&local.m_addr, local.m_length) == -1) {
 #if defined(_WIN32) || defined(_WIN64)
 			LogError("Cannot bind the UDP address, err: %lu", ::GetLastError());
 #else
@@ -156,19 +267,16 @@ bool CUDPSocket::open()
 	return true;
 }
 
-int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port)
+int CUDPSocket::read(unsigned char* buffer, unsigned int length, CUDPAddress& address)
 {
 	assert(buffer != NULL);
 	assert(length > 0U);
 
+#if defined(_WIN32) || defined(_WIN64)
 	// Check that the readfrom() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
-#if defined(_WIN32) || defined(_WIN64)
 	FD_SET((unsigned int)m_fd, &readFds);
-#else
-	FD_SET(m_fd, &readFds);
-#endif
 
 	// Return immediately
 	timeval tv;
@@ -177,28 +285,27 @@ int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& addres
 
 	int ret = ::select(m_fd + 1, &readFds, NULL, NULL, &tv);
 	if (ret < 0) {
-#if defined(_WIN32) || defined(_WIN64)
 		LogError("Error returned from UDP select, err: %lu", ::GetLastError());
-#else
-		LogError("Error returned from UDP select, err: %d", errno);
-#endif
 		return -1;
 	}
 
 	if (ret == 0)
 		return 0;
+#endif
 
-	sockaddr_in addr;
 #if defined(_WIN32) || defined(_WIN64)
-	int size = sizeof(sockaddr_in);
+	int size = sizeof(sockaddr_storage);
 #else
-	socklen_t size = sizeof(sockaddr_in);
+	socklen_t size = sizeof(sockaddr_storage);
 #endif
 
 #if defined(_WIN32) || defined(_WIN64)
-	int len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
+	int len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&address.m_addr, &size);
 #else
-	ssize_t len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
+	// Return immediately if there is nothing to read
+	ssize_t len = ::recvfrom(m_fd, (char*)buffer, length, MSG_DONTWAIT, (sockaddr *)&address.m_addr, &size);
+	if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return 0;
 #endif
 	if (len <= 0) {
 #if defined(_WIN32) || defined(_WIN64)
@@ -209,28 +316,25 @@ int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& addres
 		return -1;
 	}
 
-	address = addr.sin_addr;
-	port    = ntohs(addr.sin_port);
+	address.m_length = size;
+	fromSocket(address);
 
 	return len;
 }
 
-bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port)
+bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const CUDPAddress& address)
 {
 	assert(buffer != NULL);
 	assert(length > 0U);
 
-	sockaddr_in addr;
-	::memset(&addr, 0x00, sizeof(sockaddr_in));
-
-	addr.sin_family = AF_INET;
-	addr.sin_addr   = address;
-	addr.sin_port   = htons(port);
+	sockaddr_in6 mapped;
+	unsigned int size;
+	const sockaddr* addr = toSocket(address, mapped, size);
 
 #if defined(_WIN32) || defined(_WIN64)
-	int ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(sockaddr_in));
+	int ret = ::sendto(m_fd, (char *)buffer, length, 0, addr, size);
 #else
-	ssize_t ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(sockaddr_in));
+	ssize_t ret = ::sendto(m_fd, (char *)buffer, length, 0, addr, size);
 #endif
 	if (ret < 0) {
 #if defined(_WIN32) || defined(_WIN64)
@@ -252,6 +356,136 @@ bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const i
 	return true;
 }
 
+int CUDPSocket::read(CUDPDatagram* datagrams, unsigned int count)
+{
+	assert(datagrams != NULL);
+
+#if defined(__linux__)
+	mmsghdr msgs[MAX_BATCH];
+	iovec   iovs[MAX_BATCH];
+
+	unsigned int n = 0U;
+	while (n < count) {
+		unsigned int batch = count - n;
+		if (batch > MAX_BATCH)
+			batch = MAX_BATCH;
+
+		::memset(msgs, 0x00, batch * sizeof(mmsghdr));
+		for (unsigned int i = 0U; i < batch; i++) {
+			iovs[i].iov_base = datagrams[n + i].m_data;
+			iovs[i].iov_len  = UDP_DATAGRAM_LENGTH;
+
+			// The source address is written straight into the datagram
+			msgs[i].msg_hdr.msg_name    = &datagrams[n + i].m_address.m_addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+			msgs[i].msg_hdr.msg_iov     = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1U;
+		}
+
+		// Return immediately if there is nothing to read
+		int ret = ::recvmmsg(m_fd, msgs, batch, MSG_DONTWAIT, NULL);
+		if (ret < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+
+			LogError("Error returned from recvmmsg, err: %d", errno);
+			return -1;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			if (msgs[i].msg_len == 0U) {
+				LogError("Zero length datagram returned from recvmmsg");
+				return -1;
+			}
+
+			datagrams[n + i].m_length           = msgs[i].msg_len;
+			datagrams[n + i].m_address.m_length = msgs[i].msg_hdr.msg_namelen;
+			fromSocket(datagrams[n + i].m_address);
+		}
+
+		n += ret;
+
+		// A short batch means that the socket has been emptied
+		if ((unsigned int)ret < batch)
+			break;
+	}
+
+	return int(n);
+#else
+	unsigned int n = 0U;
+	while (n < count) {
+		int len = read(datagrams[n].m_data, UDP_DATAGRAM_LENGTH, datagrams[n].m_address);
+		if (len < 0)
+			return -1;
+		if (len == 0)
+			break;
+
+		datagrams[n].m_length = len;
+		n++;
+	}
+
+	return int(n);
+#endif
+}
+
+bool CUDPSocket::write(const CUDPDatagram* datagrams, unsigned int count)
+{
+	assert(datagrams != NULL);
+
+#if defined(__linux__)
+	mmsghdr      msgs[MAX_BATCH];
+	iovec        iovs[MAX_BATCH];
+	sockaddr_in6 mapped[MAX_BATCH];
+
+	unsigned int n = 0U;
+	while (n < count) {
+		unsigned int batch = count - n;
+		if (batch > MAX_BATCH)
+			batch = MAX_BATCH;
+
+		::memset(msgs, 0x00, batch * sizeof(mmsghdr));
+		for (unsigned int i = 0U; i < batch; i++) {
+			assert(datagrams[n + i].m_length > 0U);
+
+			// Only copied when an IPv4 address has to be mapped for a dual stack socket
+			unsigned int size;
+			const sockaddr* addr = toSocket(datagrams[n + i].m_address, mapped[i], size);
+
+			iovs[i].iov_base = (void*)datagrams[n + i].m_data;
+			iovs[i].iov_len  = datagrams[n + i].m_length;
+
+			msgs[i].msg_hdr.msg_name    = (void*)addr;
+			msgs[i].msg_hdr.msg_namelen = size;
+			msgs[i].msg_hdr.msg_iov     = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1U;
+		}
+
+		int ret = ::sendmmsg(m_fd, msgs, batch, 0);
+		if (ret <= 0) {
+			LogError("Error returned from sendmmsg, err: %d", errno);
+			return false;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			if (msgs[i].msg_len != datagrams[n + i].m_length)
+				return false;
+		}
+
+		// The kernel may stop part way through a batch, carry on from where it left off
+		n += ret;
+	}
+
+	return true;
+#else
+	for (unsigned int n = 0U; n < count; n++) {
+		if (!write(datagrams[n].m_data, datagrams[n].m_length, datagrams[n].m_address))
+			return false;
+	}
+
+	return true;
+#endif
+}
+
 void CUDPSocket::close()
 {
 #if defined(_WIN32) || defined(_WIN64)
@@ -259,4 +493,11 @@ void CUDPSocket::close()
 #else
 	::close(m_fd);
 #endif
+
+	m_fd = -1;
+}
+
+int CUDPSocket::getFd() const
+{
+	return m_fd;
 }
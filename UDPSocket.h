@@ -20,6 +20,7 @@
 #define UDPSocket_H
 
 #include <string>
+#include <cstring>
 
 #if !defined(_WIN32) && !defined(_WIN64)
 #include <netdb.h>
@@ -31,28 +32,103 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #else
-#include <winsock.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
 #endif
 
+const unsigned int UDP_DATAGRAM_LENGTH = 500U;
+
+// An IPv4 or IPv6 address along with its port
+class CUDPAddress {
+public:
+	CUDPAddress() :
+	m_addr(),
+	m_length(0U)
+	{
+		::memset(&m_addr, 0x00, sizeof(sockaddr_storage));
+	}
+
+	void setPort(unsigned int port);
+	unsigned int getPort() const;
+
+	int  getFamily() const;
+	bool isSet() const;
+
+	// The address without the port, for logging
+	std::string getHost() const;
+
+	// Compares both the address and the port, cheaply enough to be done for every packet
+	bool operator==(const CUDPAddress& address) const
+	{
+		if (m_addr.ss_family == AF_INET && address.m_addr.ss_family == AF_INET) {
+			const sockaddr_in& a = (const sockaddr_in&)m_addr;
+			const sockaddr_in& b = (const sockaddr_in&)address.m_addr;
+			return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+		}
+
+		if (m_addr.ss_family == AF_INET6 && address.m_addr.ss_family == AF_INET6) {
+			const sockaddr_in6& a = (const sockaddr_in6&)m_addr;
+			const sockaddr_in6& b = (const sockaddr_in6&)address.m_addr;
+			return a.sin6_port == b.sin6_port && a.sin6_scope_id == b.sin6_scope_id && ::memcmp(&a.sin6_addr, &b.sin6_addr, sizeof(in6_addr)) == 0;
+		}
+
+		return false;
+	}
+
+	bool operator!=(const CUDPAddress& address) const
+	{
+		return !operator==(address);
+	}
+
+	sockaddr_storage m_addr;
+	unsigned int     m_length;
+};
+
+class CUDPDatagram {
+public:
+	CUDPDatagram() :
+	m_length(0U),
+	m_address()
+	{
+	}
+
+	unsigned char m_data[UDP_DATAGRAM_LENGTH];
+	unsigned int  m_length;
+	CUDPAddress   m_address;
+};
+
 class CUDPSocket {
 public:
 	CUDPSocket(const std::string& address, unsigned int port = 0U);
 	CUDPSocket(unsigned int port = 0U);
 	~CUDPSocket();
 
-	bool open();
+	// With no local address the socket follows the family of the far end, an
+	// IPv6 socket also carries IPv4 unless the system has no IPv6 at all
+	bool open(int family = AF_UNSPEC);
+
+	int  read(unsigned char* buffer, unsigned int length, CUDPAddress& address);
+	bool write(const unsigned char* buffer, unsigned int length, const CUDPAddress& address);
 
-	int  read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
-	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
+	// Batched versions of the above, using recvmmsg() and sendmmsg() where available
+	int  read(CUDPDatagram* datagrams, unsigned int count);
+	bool write(const CUDPDatagram* datagrams, unsigned int count);
 
 	void close();
 
-	static in_addr lookup(const std::string& hostName);
+	int  getFd() const;
+
+	// Accepts a host name or an IPv4 or IPv6 literal, optionally in brackets
+	static bool lookup(const std::string& hostName, unsigned int port, CUDPAddress& address, bool numeric = false);
 
 private:
 	std::string    m_address;
 	unsigned short m_port;
 	int            m_fd;
+	int            m_family;
+
+	const sockaddr* toSocket(const CUDPAddress& address, sockaddr_in6& mapped, unsigned int& length) const;
+	static void fromSocket(CUDPAddress& address);
 };
 
 #endif
@@ -16,6 +16,9 @@
 
 #include <string>
 
+#include <cstdint>
+#include <cassert>
+
 class CUtils {
 public:
 	static void dump(const std::string& title, const unsigned char* data, unsigned int length);
@@ -30,7 +33,46 @@ public:
 	static void bitsToByteBE(const bool* bits, unsigned char& byte);
 	static void bitsToByteLE(const bool* bits, unsigned char& byte);
 
+	// Fields of up to 32 bits at any bit offset in a packed buffer, with the
+	// first bit in the top bit of the first byte
+	static uint32_t getBits(const unsigned char* in, unsigned int start, unsigned int count);
+	static void     setBits(unsigned char* out, unsigned int start, unsigned int count, uint32_t value);
+
 private:
 };
 
+inline uint32_t CUtils::getBits(const unsigned char* in, unsigned int start, unsigned int count)
+{
+	assert(in != NULL);
+	assert(count > 0U && count <= 32U);
+
+	unsigned int first = start >> 3;
+	unsigned int last  = (start + count - 1U) >> 3;
+
+	uint64_t value = 0U;
+	for (unsigned int i = first; i <= last; i++)
+		value = (value << 8) | in[i];
+
+	value >>= (last + 1U) * 8U - (start + count);
+
+	return uint32_t(value & ((uint64_t(1U) << count) - 1U));
+}
+
+inline void CUtils::setBits(unsigned char* out, unsigned int start, unsigned int count, uint32_t value)
+{
+	assert(out != NULL);
+	assert(count > 0U && count <= 32U);
+
+	unsigned int first = start >> 3;
+	unsigned int last  = (start + count - 1U) >> 3;
+	unsigned int shift = (last + 1U) * 8U - (start + count);
+
+	uint64_t mask = ((uint64_t(1U) << count) - 1U) << shift;
+	uint64_t bits = (uint64_t(value) << shift) & mask;
+
+	// From the last byte backwards, the bits for each byte are in the bottom of the mask
+	for (unsigned int i = last + 1U; i > first; i--, mask >>= 8, bits >>= 8)
+		out[i - 1U] = (out[i - 1U] & ~(unsigned char)mask) | (unsigned char)bits;
+}
+
 #endif
@@ -65,9 +65,6 @@ m_it()
 
 CVoice::~CVoice()
 {
-	for (std::vector<CDMRData*>::iterator it = m_data.begin(); it != m_data.end(); ++it)
-		delete *it;
-
 	for (std::unordered_map<std::string, CPositions*>::iterator it = m_positions.begin(); it != m_positions.end(); ++it)
 		delete it->second;
 
@@ -207,9 +204,6 @@ void CVoice::createVoice(const std::vector<std::string>& words)
 		}
 	}
 		
-	for (std::vector<CDMRData*>::iterator it = m_data.begin(); it != m_data.end(); ++it)
-		delete *it;
-
 	m_data.clear();
 
 	m_streamId = ::rand() + 1U;
@@ -225,15 +219,15 @@ void CVoice::createVoice(const std::vector<std::string>& words)
 	for (unsigned int i = 0U; i < ambeLength; i += (3U * AMBE_LENGTH)) {
 		unsigned char* p = ambeData + i;
 
-		CDMRData* data = new CDMRData;
+		CDMRData data;
 
-		data->setSlotNo(m_slot);
-		data->setFLCO(FLCO_GROUP);
-		data->setSrcId(m_lc.getSrcId());
-		data->setDstId(m_lc.getDstId());
-		data->setN(n);
-		data->setSeqNo(m_seqNo++);
-		data->setStreamId(m_streamId);
+		data.setSlotNo(m_slot);
+		data.setFLCO(FLCO_GROUP);
+		data.setSrcId(m_lc.getSrcId());
+		data.setDstId(m_lc.getDstId());
+		data.setN(n);
+		data.setSeqNo(m_seqNo++);
+		data.setStreamId(m_streamId);
 
 		::memcpy(buffer + 0U, p + 0U, AMBE_LENGTH);
 		::memcpy(buffer + 9U, p + 9U, AMBE_LENGTH);
@@ -242,7 +236,7 @@ void CVoice::createVoice(const std::vector<std::string>& words)
 
 		if (n == 0U) {
 			CSync::addDMRAudioSync(buffer, true);
-			data->setDataType(DT_VOICE_SYNC);
+			data.setDataType(DT_VOICE_SYNC);
 		} else {
 			unsigned char lcss = m_embeddedLC.getData(buffer, n);
 
@@ -252,14 +246,14 @@ void CVoice::createVoice(const std::vector<std::string>& words)
 			emb.setLCSS(lcss);
 			emb.getData(buffer);
 
-			data->setDataType(DT_VOICE);
+			data.setDataType(DT_VOICE);
 		}
 
 		n++;
 		if (n >= 6U)
 			n = 0U;
 
-		data->setData(buffer);
+		data.setData(buffer);
 
 		m_data.push_back(data);
 	}
@@ -281,14 +275,12 @@ bool CVoice::read(CDMRData& data)
 	unsigned int count = m_stopWatch.elapsed() / DMR_SLOT_TIME;
 
 	if (m_sent < count) {
-		data = *(*m_it);
+		data = *m_it;
 
 		++m_sent;
 		++m_it;
 
 		if (m_it == m_data.end()) {
-			for (std::vector<CDMRData*>::iterator it = m_data.begin(); it != m_data.end(); ++it)
-				delete *it;
 			m_data.clear();
 			m_timer.stop();
 			m_status = VS_NONE;
@@ -313,18 +305,35 @@ void CVoice::clock(unsigned int ms)
 	}
 }
 
+unsigned int CVoice::getDeadline(unsigned int ms)
+{
+	if (m_status == VS_WAITING)
+		return m_timer.getDeadline(ms);
+
+	if (m_status != VS_SENDING)
+		return ms;
+
+	// The time until the next frame is due to be sent
+	unsigned int elapsed = m_stopWatch.elapsed();
+	unsigned int due     = (m_sent + 1U) * DMR_SLOT_TIME;
+	if (due <= elapsed)
+		return 0U;
+
+	return (due - elapsed) < ms ? (due - elapsed) : ms;
+}
+
 void CVoice::createHeaderTerminator(unsigned char type)
 {
-	CDMRData* data = new CDMRData;
+	CDMRData data;
 
-	data->setSlotNo(m_slot);
-	data->setFLCO(FLCO_GROUP);
-	data->setSrcId(m_lc.getSrcId());
-	data->setDstId(m_lc.getDstId());
-	data->setDataType(type);
-	data->setN(0U);
-	data->setSeqNo(m_seqNo++);
-	data->setStreamId(m_streamId);
+	data.setSlotNo(m_slot);
+	data.setFLCO(FLCO_GROUP);
+	data.setSrcId(m_lc.getSrcId());
+	data.setDstId(m_lc.getDstId());
+	data.setDataType(type);
+	data.setN(0U);
+	data.setSeqNo(m_seqNo++);
+	data.setStreamId(m_streamId);
 
 	unsigned char buffer[DMR_FRAME_LENGTH_BYTES];
 
@@ -338,7 +347,7 @@ void CVoice::createHeaderTerminator(unsigned char type)
 
 	CSync::addDMRDataSync(buffer, true);
 
-	data->setData(buffer);
+	data.setData(buffer);
 
 	m_data.push_back(data);
 }
@@ -54,6 +54,8 @@ public:
 
 	void clock(unsigned int ms);
 
+	unsigned int getDeadline(unsigned int ms);
+
 private:
 	std::string                            m_indxFile;
 	std::string                            m_ambeFile;
@@ -68,8 +70,8 @@ private:
 	unsigned int                           m_sent;
 	unsigned char*                         m_ambe;
 	std::unordered_map<std::string, CPositions*> m_positions;
-	std::vector<CDMRData*>                 m_data;
-	std::vector<CDMRData*>::const_iterator m_it;
+	std::vector<CDMRData>                  m_data;
+	std::vector<CDMRData>::const_iterator  m_it;
 
 	void createHeaderTerminator(unsigned char type);
 	void createVoice(const std::vector<std::string>& words);